@@ -80,7 +80,8 @@ std::tuple<int32_t, RetAppEventPackage> AppEventPackageHolderImpl::TakeNext()
     std::vector<std::shared_ptr<AppEventPack>> events;
     int32_t ret = ERR_PARAM;
     RetAppEventPackage package;
-    if (AppEventStoreFacade::QueryEvents(events, observerSeq_) != 0) {
+    // the events are read only until the size is reached instead of reading all the events
+    if (AppEventStoreFacade::QueryEventsBySize(events, observerSeq_, static_cast<int>(takeSize_)) != 0) {
         LOGE("failed to query events, seq=%{public}" PRId64, observerSeq_);
         return {ret, package};
     }
@@ -92,13 +93,8 @@ std::tuple<int32_t, RetAppEventPackage> AppEventPackageHolderImpl::TakeNext()
     std::vector<std::string> eventStrs;
     size_t totalSize = 0;
     for (const auto& event : events) {
-        std::string eventStr = event->GetEventStr();
-        if (static_cast<int>(totalSize + eventStr.size()) > takeSize_) {
-            LOGI("stop to take data, totalSize=%{public}zu, takeSize=%{public}" PRIi64 "", totalSize, takeSize_);
-            break;
-        }
-        totalSize += eventStr.size();
-        eventStrs.emplace_back(eventStr);
+        totalSize += event->GetEventSize();
+        eventStrs.emplace_back(event->GetEventStr());
         eventSeqs.emplace_back(event->GetSeq());
     }
     if (eventStrs.empty()) {
@@ -15,7 +15,6 @@
 #include "hiappevent_impl.h"
 
 #include <cinttypes>
-#include <mutex>
 #include <string>
 
 #include "appevent_watcher_impl.h"
@@ -30,7 +29,6 @@ using namespace OHOS::HiviewDFX::HiAppEvent;
 namespace OHOS {
 namespace CJSystemapi {
 namespace HiAppEvent {
-std::mutex g_mutex;
 int HiAppEventImpl::Configure(bool disable, const std::string& maxStorage)
 {
     std::string disableStr = disable == true ? "true" : "false";
@@ -47,36 +45,6 @@ int HiAppEventImpl::Configure(bool disable, const std::string& maxStorage)
     return SUCCESS_CODE;
 }
 
-std::string GetStorageDirPath()
-{
-    return AppEventConfigFacade::GetStorageDir();
-}
-
-uint64_t GetMaxStorageSize()
-{
-    return AppEventConfigFacade::GetMaxStorageSize();
-}
-
-std::string GetStorageFileName()
-{
-    return "app_event_" + AppEventUtilityFacade::GetDate() + ".log";
-}
-
-void CheckStorageSpace(const std::string& dir)
-{
-    auto maxSize = GetMaxStorageSize();
-    if (!AppEventStoreFacade::IsStorageSpaceFull(dir, maxSize)) {
-        return;
-    }
-    LOGI("hiappevent dir space is full, start to clean");
-    AppEventStoreFacade::ReleaseSomeStorageSpace(dir, maxSize);
-}
-
-bool WriteEventToFile(const std::string& filePath, const std::string& event)
-{
-    return AppEventUtilityFacade::SaveStringToFile(filePath, event);
-}
-
 void HiWriteEvent(std::shared_ptr<AppEventPack> appEventPack)
 {
     if (AppEventConfigFacade::GetDisable()) {
@@ -87,28 +55,8 @@ void HiWriteEvent(std::shared_ptr<AppEventPack> appEventPack)
         LOGE("appEventPack is null.");
         return;
     }
-    std::string dirPath = GetStorageDirPath();
-    if (dirPath.empty()) {
-        LOGE("dirPath is null, stop writing the event.");
-        return;
-    }
-    std::string event = appEventPack->GetEventStr();
-    {
-        std::lock_guard<std::mutex> lockGuard(g_mutex);
-        if (!AppEventUtilityFacade::IsFileExists(dirPath) && !AppEventUtilityFacade::ForceCreateDirectory(dirPath)) {
-            LOGE("failed to create hiappevent dir, errno=%{public}d.", errno);
-            return;
-        }
-        CheckStorageSpace(dirPath);
-        std::string filePath = AppEventUtilityFacade::GetFilePathByDir(dirPath, GetStorageFileName());
-        if (WriteEventToFile(filePath, event)) {
-            std::vector<std::shared_ptr<AppEventPack>> events;
-            events.emplace_back(appEventPack);
-            AppEventObserverFacade::HandleEvents(events);
-            return;
-        }
-        LOGE("failed to write event to log file, errno=%{public}d.", errno);
-    }
+    // share the opened log file and the observers handling with the native writing path
+    AppEventWriteFacade::FacadeWriteEvent(appEventPack);
 }
 
 int HiAppEventImpl::Write(std::shared_ptr<HiviewDFX::AppEventPack> appEventPack)
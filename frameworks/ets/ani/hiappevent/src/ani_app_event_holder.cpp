@@ -177,8 +177,10 @@ std::shared_ptr<AppEventPackage> AniAppEventHolder::TakeNext()
 {
     std::vector<std::shared_ptr<AppEventPack>> events;
     bool shouldTakeSize = hasSetSize_ && !hasSetRow_;
-    int rowNum = shouldTakeSize ? 0 : takeRow_;
-    if (AppEventStoreFacade::QueryEvents(events, observerSeq_, rowNum) != 0) {
+    // the events are read only until the size is reached instead of reading all the events
+    int ret = shouldTakeSize ? AppEventStoreFacade::QueryEventsBySize(events, observerSeq_, takeSize_)
+        : AppEventStoreFacade::QueryEvents(events, observerSeq_, takeRow_);
+    if (ret != 0) {
         HILOG_WARN(LOG_CORE, "failed to query events, seq=%{public}" PRId64, observerSeq_);
         return nullptr;
     }
@@ -192,14 +194,8 @@ std::shared_ptr<AppEventPackage> AniAppEventHolder::TakeNext()
     size_t totalSize = 0;
     auto package = std::make_shared<AppEventPackage>();
     for (auto event : events) {
-        std::string eventStr = event->GetEventStr();
-        if (shouldTakeSize && static_cast<int>(totalSize + eventStr.size()) > takeSize_) {
-            HILOG_INFO(LOG_CORE, "stop to take data, totalSize=%{public}zu, takeSize=%{public}d",
-                totalSize, takeSize_);
-            break;
-        }
-        totalSize += eventStr.size();
-        eventStrs.emplace_back(eventStr);
+        totalSize += event->GetEventSize();
+        eventStrs.emplace_back(event->GetEventStr());
         eventSeqs.emplace_back(event->GetSeq());
         package->events.emplace_back(event);
     }
@@ -16,6 +16,7 @@
 #include "api_stats_dao.h"
 
 #include "app_event_cache_common.h"
+#include "event_json_util.h"
 #include "hilog/log.h"
 #include "rdb_helper.h"
 #include "sql_util.h"
@@ -31,76 +32,179 @@ namespace HiviewDFX {
 namespace ApiStatsDao {
 using namespace AppEventCacheCommon;
 using namespace AppEventCacheCommon::ApiStats;
+namespace {
+enum AggregatedColumn : int {
+    COL_KITNAME = 0,
+    COL_APINAME,
+    COL_CALL_TIMES,
+    COL_SUCCESS_TIMES,
+    COL_MAX_COST_TIME,
+    COL_MIN_COST_TIME,
+    COL_TOTAL_COST_TIME,
+    COL_ERROR_CODES,
+};
+
+const std::string& InsertSql()
+{
+    static const std::string sql = SqlUtil::Insert(TABLE, {
+        FIELD_KITNAME, FIELD_APINAME, FIELD_CALL_TIMES, FIELD_SUCCESS_TIMES, FIELD_MAX_COST_TIME,
+        FIELD_MIN_COST_TIME, FIELD_TOTAL_COST_TIME, FIELD_ERROR_CODES,
+    });
+    return sql;
+}
+
+// in the order of AggregatedColumn
+const std::string& QueryAggregatedSql()
+{
+    static const std::string sql = "SELECT " + FIELD_KITNAME + ", " + FIELD_APINAME + ", SUM(" + FIELD_CALL_TIMES
+        + "), SUM(" + FIELD_SUCCESS_TIMES + "), MAX(" + FIELD_MAX_COST_TIME + "), MIN(" + FIELD_MIN_COST_TIME
+        + "), SUM(" + FIELD_TOTAL_COST_TIME + "), GROUP_CONCAT(" + FIELD_ERROR_CODES + ") FROM " + TABLE
+        + " GROUP BY " + FIELD_KITNAME + ", " + FIELD_APINAME;
+    return sql;
+}
+
+// the column of version 6 which keeps a single call as json
+const std::string FIELD_METRIC = "metric";
+
+bool ParseMetric(const std::string& metricStr, ApiStatsRecord& record)
+{
+    Json::Value metric;
+    if (!EventJsonUtil::GetJsonObjectFromJsonString(metric, metricStr)) {
+        return false;
+    }
+    if (!metric["errCode"].isInt() || !metric["duration"].isInt() || !metric["successful"].isBool()
+        || metric["duration"].asInt() < 0) {
+        return false;
+    }
+    record.callTimes = 1;
+    record.successTimes = metric["successful"].asBool() ? 1 : 0;
+    record.maxCostTime = metric["duration"].asInt();
+    record.minCostTime = record.maxCostTime;
+    record.totalCostTime = record.maxCostTime;
+    record.errorCodes = std::to_string(metric["errCode"].asInt()) + ":1";
+    return true;
+}
+}
+
 int Create(NativeRdb::RdbStore& dbStore)
 {
     /**
      * table: api_stats
      *
-     * |----------------|-------------|---------|
-     * |    kit_name    |  api_name   | metric  |
-     * |----------------|-------------|---------|
-     * |     TEXT       |    TEXT     |  TEXT   |
-     * |----------------|-------------|---------|
+     * |--------|--------|----------|-------------|-------------|-------------|---------------|-----------|
+     * |kit_name|api_name|call_times|success_times|max_cost_time|min_cost_time|total_cost_time|error_codes|
+     * |--------|--------|----------|-------------|-------------|-------------|---------------|-----------|
+     * |  TEXT  |  TEXT  | INTEGER  |   INTEGER   |   INTEGER   |   INTEGER   |    INTEGER    |    TEXT   |
+     * |--------|--------|----------|-------------|-------------|-------------|---------------|-----------|
      */
     const std::vector<std::pair<std::string, std::string>> fields = {
         {FIELD_KITNAME, SqlUtil::SQL_TEXT_TYPE},
         {FIELD_APINAME, SqlUtil::SQL_TEXT_TYPE},
-        {FIELD_METRIC, SqlUtil::SQL_TEXT_TYPE},
+        {FIELD_CALL_TIMES, SqlUtil::SQL_INT_TYPE},
+        {FIELD_SUCCESS_TIMES, SqlUtil::SQL_INT_TYPE},
+        {FIELD_MAX_COST_TIME, SqlUtil::SQL_INT_TYPE},
+        {FIELD_MIN_COST_TIME, SqlUtil::SQL_INT_TYPE},
+        {FIELD_TOTAL_COST_TIME, SqlUtil::SQL_INT_TYPE},
+        {FIELD_ERROR_CODES, SqlUtil::SQL_TEXT_TYPE},
     };
     std::string sql = SqlUtil::CreateTable(TABLE, fields);
     return dbStore.ExecuteSql(sql);
 }
 
-int MetricInsert(std::shared_ptr<NativeRdb::RdbStore> dbStore, const std::string& kitName, const std::string& apiName,
-    const std::string& metric)
+int BatchInsert(std::shared_ptr<NativeRdb::RdbStore> dbStore, const std::vector<ApiStatsRecord>& records)
 {
-    NativeRdb::ValuesBucket bucket;
-    bucket.PutString(FIELD_KITNAME, kitName);
-    bucket.PutString(FIELD_APINAME, apiName);
-    bucket.PutString(FIELD_METRIC, metric);
-
-    int64_t seq = 0;
-    int ret = dbStore->Insert(seq, TABLE, bucket);
-    HILOG_INFO(LOG_CORE, "insert api stats, kitName=%{public}s, apiName=%{public}s, ret=%{public}d",
-        kitName.c_str(), apiName.c_str(), ret);
-    return ret;
+    return BatchInsert(*dbStore, records);
 }
 
-int MetricQueryAll(std::shared_ptr<NativeRdb::RdbStore> dbStore,
-    std::map<std::pair<std::string, std::string>, std::vector<std::string>>& out)
+int BatchInsert(NativeRdb::RdbStore& dbStore, const std::vector<ApiStatsRecord>& records)
 {
-    NativeRdb::AbsRdbPredicates predicates(TABLE);
-    auto resultSet = dbStore->Query(predicates, {FIELD_KITNAME, FIELD_APINAME, FIELD_METRIC});
+    const std::string& sql = InsertSql();
+    for (const auto& record : records) {
+        std::vector<NativeRdb::ValueObject> bindArgs = {
+            NativeRdb::ValueObject(record.kitName),
+            NativeRdb::ValueObject(record.apiName),
+            NativeRdb::ValueObject(record.callTimes),
+            NativeRdb::ValueObject(record.successTimes),
+            NativeRdb::ValueObject(record.maxCostTime),
+            NativeRdb::ValueObject(record.minCostTime),
+            NativeRdb::ValueObject(record.totalCostTime),
+            NativeRdb::ValueObject(record.errorCodes),
+        };
+        if (int ret = dbStore.ExecuteSql(sql, bindArgs); ret != NativeRdb::E_OK) {
+            HILOG_ERROR(LOG_CORE, "failed to insert api stats, kitName=%{public}s, apiName=%{public}s, "
+                "ret=%{public}d", record.kitName.c_str(), record.apiName.c_str(), ret);
+            return ret;
+        }
+    }
+    HILOG_INFO(LOG_CORE, "insert api stats, count=%{public}zu", records.size());
+    return NativeRdb::E_OK;
+}
+
+int QueryAggregated(std::shared_ptr<NativeRdb::RdbStore> dbStore, std::vector<ApiStatsRecord>& records)
+{
+    auto resultSet = dbStore->QuerySql(QueryAggregatedSql());
+    if (resultSet == nullptr) {
+        HILOG_ERROR(LOG_CORE, "failed to query table");
+        return NativeRdb::E_ERROR;
+    }
+
+    records.clear();
+    int ret = NativeRdb::E_OK;
+    while ((ret = resultSet->GoToNextRow()) == NativeRdb::E_OK) {
+        ApiStatsRecord record;
+        if (resultSet->GetString(COL_KITNAME, record.kitName) == NativeRdb::E_OK &&
+            resultSet->GetString(COL_APINAME, record.apiName) == NativeRdb::E_OK &&
+            resultSet->GetLong(COL_CALL_TIMES, record.callTimes) == NativeRdb::E_OK &&
+            resultSet->GetLong(COL_SUCCESS_TIMES, record.successTimes) == NativeRdb::E_OK &&
+            resultSet->GetLong(COL_MAX_COST_TIME, record.maxCostTime) == NativeRdb::E_OK &&
+            resultSet->GetLong(COL_MIN_COST_TIME, record.minCostTime) == NativeRdb::E_OK &&
+            resultSet->GetLong(COL_TOTAL_COST_TIME, record.totalCostTime) == NativeRdb::E_OK &&
+            resultSet->GetString(COL_ERROR_CODES, record.errorCodes) == NativeRdb::E_OK) {
+            records.emplace_back(std::move(record));
+        }
+    }
+
+    resultSet->Close();
+    HILOG_INFO(LOG_CORE, "query aggregated api stats, count=%{public}zu, ret=%{public}d", records.size(), ret);
+    return ret == NativeRdb::E_SQLITE_CORRUPT ? ret : NativeRdb::E_OK;
+}
+
+int QueryMetrics(NativeRdb::RdbStore& dbStore, std::vector<ApiStatsRecord>& records)
+{
+    auto resultSet = dbStore.QuerySql("SELECT " + FIELD_KITNAME + ", " + FIELD_APINAME + ", " + FIELD_METRIC
+        + " FROM " + TABLE);
     if (resultSet == nullptr) {
         HILOG_ERROR(LOG_CORE, "failed to query table");
         return NativeRdb::E_ERROR;
     }
 
-    out.clear();
+    records.clear();
     int ret = NativeRdb::E_OK;
     const int COLUMN_INDEX_KIT = 0;
     const int COLUMN_INDEX_API = 1;
     const int COLUMN_INDEX_METRIC = 2;
-    do {
-        ret = resultSet->GoToNextRow();
-        if (ret == NativeRdb::E_OK) {
-            std::string kitName;
-            std::string apiName;
-            std::string metric;
-            if (resultSet->GetString(COLUMN_INDEX_KIT, kitName) == NativeRdb::E_OK &&
-                resultSet->GetString(COLUMN_INDEX_API, apiName) == NativeRdb::E_OK &&
-                resultSet->GetString(COLUMN_INDEX_METRIC, metric) == NativeRdb::E_OK) {
-                out[std::make_pair(kitName, apiName)].emplace_back(metric);
-            }
+    while ((ret = resultSet->GoToNextRow()) == NativeRdb::E_OK) {
+        ApiStatsRecord record;
+        std::string metric;
+        if (resultSet->GetString(COLUMN_INDEX_KIT, record.kitName) != NativeRdb::E_OK ||
+            resultSet->GetString(COLUMN_INDEX_API, record.apiName) != NativeRdb::E_OK ||
+            resultSet->GetString(COLUMN_INDEX_METRIC, metric) != NativeRdb::E_OK) {
+            continue;
         }
-    } while (ret == NativeRdb::E_OK);
+        if (!ParseMetric(metric, record)) {
+            HILOG_WARN(LOG_CORE, "failed to parse the metric, kitName=%{public}s, apiName=%{public}s",
+                record.kitName.c_str(), record.apiName.c_str());
+            continue;
+        }
+        records.emplace_back(std::move(record));
+    }
 
     resultSet->Close();
-    HILOG_INFO(LOG_CORE, "query all api stats, group count=%{public}zu, ret=%{public}d", out.size(), ret);
+    HILOG_INFO(LOG_CORE, "query api metrics, count=%{public}zu, ret=%{public}d", records.size(), ret);
     return ret == NativeRdb::E_SQLITE_CORRUPT ? ret : NativeRdb::E_OK;
 }
 
-int MetricClear(std::shared_ptr<NativeRdb::RdbStore> dbStore)
+int Clear(std::shared_ptr<NativeRdb::RdbStore> dbStore)
 {
     NativeRdb::AbsRdbPredicates predicates(TABLE);
     int deleteRows = 0;
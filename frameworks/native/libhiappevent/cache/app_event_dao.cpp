@@ -15,6 +15,7 @@
 #include "app_event_dao.h"
 
 #include "app_event_cache_common.h"
+#include "app_event_statement.h"
 #include "app_event_store.h"
 #include "hiappevent_base.h"
 #include "hilog/log.h"
@@ -37,15 +38,15 @@ int Create(NativeRdb::RdbStore& dbStore)
      * table: events
      *
      * |-------|--------|------|------|------|-----|-----|----------|---------|----------|------------|--------|
-     * ------------|
+     * ------------|-------|
      * |  seq  | domain | name | type |  tz  | pid | tid | trace_id | span_id | pspan_id | trace_flag | params |
-     *  running_id |
+     *  running_id |  size |
      * |-------|--------|------|------|------|-----|-----|----------|---------|----------|------------|--------|
-     * ------------|
+     * ------------|-------|
      * | INT64 |  TEXT  | TEXT |  INT | TEXT | INT | INT |  INT64   |  INT64  |   INT64  |    INT     |  TEXT  |
-     *     TEXT    |
+     *     TEXT    | INT64 |
      * |-------|--------|------|------|------|-----|-----|----------|---------|----------|------------|--------|
-     * ------------|
+     * ------------|-------|
      */
     const std::vector<std::pair<std::string, std::string>> fields = {
         {Events::FIELD_DOMAIN, SqlUtil::SQL_TEXT_TYPE},
@@ -61,28 +62,37 @@ int Create(NativeRdb::RdbStore& dbStore)
         {Events::FIELD_TRACE_FLAG, SqlUtil::SQL_INT_TYPE},
         {Events::FIELD_PARAMS, SqlUtil::SQL_TEXT_TYPE},
         {Events::FIELD_RUNNING_ID, SqlUtil::SQL_TEXT_TYPE},
+        {Events::FIELD_SIZE, SqlUtil::SQL_INT_TYPE},
     };
     std::string sql = SqlUtil::CreateTable(Events::TABLE, fields);
     return dbStore.ExecuteSql(sql);
 }
 
-int Insert(std::shared_ptr<NativeRdb::RdbStore> dbStore, std::shared_ptr<AppEventPack> event, int64_t& seq)
+int Insert(std::shared_ptr<NativeRdb::RdbStore> dbStore, std::shared_ptr<AppEventPack> event, int64_t size,
+    int64_t& seq)
 {
-    NativeRdb::ValuesBucket bucket;
-    bucket.PutString(Events::FIELD_DOMAIN, event->GetDomain());
-    bucket.PutString(Events::FIELD_NAME, event->GetName());
-    bucket.PutInt(Events::FIELD_TYPE, event->GetType());
-    bucket.PutLong(Events::FIELD_TIME, event->GetTime());
-    bucket.PutString(Events::FIELD_TZ, event->GetTimeZone());
-    bucket.PutInt(Events::FIELD_PID, event->GetPid());
-    bucket.PutInt(Events::FIELD_TID, event->GetTid());
-    bucket.PutLong(Events::FIELD_TRACE_ID, event->GetTraceId());
-    bucket.PutLong(Events::FIELD_SPAN_ID, event->GetSpanId());
-    bucket.PutLong(Events::FIELD_PSPAN_ID, event->GetPspanId());
-    bucket.PutInt(Events::FIELD_TRACE_FLAG, event->GetTraceFlag());
-    bucket.PutString(Events::FIELD_PARAMS, event->GetParamStr());
-    bucket.PutString(Events::FIELD_RUNNING_ID, event->GetRunningId());
-    return dbStore->Insert(seq, Events::TABLE, bucket);
+    std::vector<NativeRdb::ValueObject> bindArgs;
+    AppEventStatement::GetEventBindArgs(event, size, bindArgs);
+    return dbStore->ExecuteForLastInsertedRowId(seq, AppEventStatement::InsertEvent(), bindArgs);
+}
+
+int BatchInsert(std::shared_ptr<NativeRdb::RdbStore> dbStore, const std::vector<std::shared_ptr<AppEventPack>>& events,
+    const std::vector<int64_t>& sizes, std::vector<int64_t>& seqs)
+{
+    const std::string& sql = AppEventStatement::InsertEvent();
+    seqs.clear();
+    seqs.reserve(events.size());
+    std::vector<NativeRdb::ValueObject> bindArgs;
+    for (size_t i = 0; i < events.size() && i < sizes.size(); ++i) {
+        AppEventStatement::GetEventBindArgs(events[i], sizes[i], bindArgs);
+        int64_t seq = 0;
+        if (int ret = dbStore->ExecuteForLastInsertedRowId(seq, sql, bindArgs); ret != NativeRdb::E_OK) {
+            HILOG_ERROR(LOG_CORE, "failed to insert event, ret=%{public}d", ret);
+            return ret;
+        }
+        seqs.emplace_back(seq);
+    }
+    return NativeRdb::E_OK;
 }
 
 int Delete(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t eventSeq)
@@ -115,6 +125,34 @@ int Delete(std::shared_ptr<NativeRdb::RdbStore> dbStore, const std::vector<int64
     HILOG_INFO(LOG_CORE, "delete %{public}d records, ret=%{public}d", deleteRows, ret);
     return ret;
 }
+
+int DeleteBefore(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t maxEventSeq)
+{
+    NativeRdb::AbsRdbPredicates predicates(Events::TABLE);
+    predicates.LessThanOrEqualTo(Events::FIELD_SEQ, maxEventSeq);
+    int deleteRows = 0;
+    int ret = dbStore->Delete(deleteRows, predicates);
+    HILOG_INFO(LOG_CORE, "delete %{public}d records, maxEventSeq=%{public}" PRId64 ", ret=%{public}d",
+        deleteRows, maxEventSeq, ret);
+    return ret;
+}
+
+int QueryMaxSeq(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t& seq)
+{
+    std::string sql = std::string("SELECT MAX(") + Events::FIELD_SEQ + ") FROM " + Events::TABLE;
+    auto resultSet = dbStore->QuerySql(sql);
+    if (resultSet == nullptr) {
+        HILOG_ERROR(LOG_CORE, "failed to query the max seq of events");
+        return NativeRdb::E_ERROR;
+    }
+    // the max seq is null if the table is empty, then the seq is not changed
+    int ret = resultSet->GoToNextRow();
+    if (ret == NativeRdb::E_OK) {
+        (void)resultSet->GetLong(0, seq);
+    }
+    resultSet->Close();
+    return ret == NativeRdb::E_SQLITE_CORRUPT ? ret : NativeRdb::E_OK;
+}
 } // namespace AppEventDao
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -66,6 +66,22 @@ int Insert(std::shared_ptr<NativeRdb::RdbStore> dbStore, const std::vector<Event
     return dbStore->BatchInsert(insertRows, TABLE, buckets);
 }
 
+int BatchInsert(std::shared_ptr<NativeRdb::RdbStore> dbStore, const std::vector<EventObserverInfo>& eventObservers)
+{
+    // executed row by row with the same statement, so it can be a part of the caller's transaction
+    static const std::string sql = SqlUtil::Insert(TABLE, {FIELD_EVENT_SEQ, FIELD_OBSERVER_SEQ});
+    for (const auto& eventObserver : eventObservers) {
+        int ret = dbStore->ExecuteSql(sql, {
+            NativeRdb::ValueObject(eventObserver.eventSeq), NativeRdb::ValueObject(eventObserver.observerSeq)
+        });
+        if (ret != NativeRdb::E_OK) {
+            HILOG_ERROR(LOG_CORE, "failed to insert mapping, ret=%{public}d", ret);
+            return ret;
+        }
+    }
+    return NativeRdb::E_OK;
+}
+
 int Delete(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t observerSeq, const std::vector<int64_t>& eventSeqs)
 {
     NativeRdb::AbsRdbPredicates predicates(TABLE);
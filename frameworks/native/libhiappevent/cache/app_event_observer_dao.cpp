@@ -35,16 +35,17 @@ int Create(NativeRdb::RdbStore& dbStore)
     /**
      * table: observers
      *
-     * |-------|------|------|---------|
-     * |  seq  | name | hash | filters |
-     * |-------|------|------|---------|
-     * | INT64 | TEXT | INT64|   TEXT  |
-     * |-------|------|------|---------|
+     * |-------|------|------|---------|--------|
+     * |  seq  | name | hash | filters | cursor |
+     * |-------|------|------|---------|--------|
+     * | INT64 | TEXT | INT64|   TEXT  | INT64  |
+     * |-------|------|------|---------|--------|
      */
     const std::vector<std::pair<std::string, std::string>> fields = {
         {FIELD_NAME, SqlUtil::SQL_TEXT_TYPE},
         {FIELD_HASH, SqlUtil::SQL_INT_TYPE},
         {FIELD_FILTERS, SqlUtil::SQL_TEXT_TYPE},
+        {FIELD_CURSOR, SqlUtil::SQL_INT_TYPE},
     };
     std::string sql = SqlUtil::CreateTable(TABLE, fields);
     return dbStore.ExecuteSql(sql);
@@ -56,6 +57,7 @@ int Insert(std::shared_ptr<NativeRdb::RdbStore> dbStore, const Observer& observe
     bucket.PutString(FIELD_NAME, observer.name);
     bucket.PutLong(FIELD_HASH, observer.hashCode);
     bucket.PutString(FIELD_FILTERS, observer.filters);
+    bucket.PutLong(FIELD_CURSOR, observer.cursor);
     return dbStore->Insert(seq, TABLE, bucket);
 }
 
@@ -73,6 +75,53 @@ int Update(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t seq, const std:
     return ret;
 }
 
+int UpdateCursor(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t seq, int64_t cursor)
+{
+    NativeRdb::ValuesBucket bucket;
+    bucket.PutLong(FIELD_CURSOR, cursor);
+
+    // the cursor only moves forward
+    int changedRows = 0;
+    NativeRdb::AbsRdbPredicates predicates(TABLE);
+    predicates.EqualTo(FIELD_SEQ, seq);
+    predicates.LessThan(FIELD_CURSOR, cursor);
+    return dbStore->Update(changedRows, bucket, predicates);
+}
+
+int QueryCursor(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t seq, int64_t& cursor)
+{
+    NativeRdb::AbsRdbPredicates predicates(TABLE);
+    predicates.EqualTo(FIELD_SEQ, seq);
+    auto resultSet = dbStore->Query(predicates, {FIELD_CURSOR});
+    if (resultSet == nullptr) {
+        HILOG_ERROR(LOG_CORE, "failed to query cursor, observer seq=%{public}" PRId64, seq);
+        return NativeRdb::E_ERROR;
+    }
+    int ret = resultSet->GoToNextRow();
+    if (ret == NativeRdb::E_OK && resultSet->GetLong(0, cursor) != NativeRdb::E_OK) {
+        HILOG_WARN(LOG_CORE, "failed to get cursor, observer seq=%{public}" PRId64, seq);
+    }
+    resultSet->Close();
+    return ret == NativeRdb::E_SQLITE_CORRUPT ? ret : NativeRdb::E_OK;
+}
+
+int QueryMinCursor(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t& cursor, bool& isExist)
+{
+    std::string sql = std::string("SELECT MIN(") + FIELD_CURSOR + "), COUNT(*) FROM " + TABLE;
+    auto resultSet = dbStore->QuerySql(sql);
+    if (resultSet == nullptr) {
+        HILOG_ERROR(LOG_CORE, "failed to query the min cursor");
+        return NativeRdb::E_ERROR;
+    }
+    int ret = resultSet->GoToNextRow();
+    int count = 0;
+    if (ret == NativeRdb::E_OK && resultSet->GetInt(1, count) == NativeRdb::E_OK && count > 0) {
+        isExist = (resultSet->GetLong(0, cursor) == NativeRdb::E_OK);
+    }
+    resultSet->Close();
+    return ret == NativeRdb::E_SQLITE_CORRUPT ? ret : NativeRdb::E_OK;
+}
+
 int QuerySeqAndFilters(std::shared_ptr<NativeRdb::RdbStore> dbStore, const Observer& observer,
     int64_t& seq, std::string& filters)
 {
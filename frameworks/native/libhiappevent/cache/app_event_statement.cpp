@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "app_event_statement.h"
+
+#include "app_event_cache_common.h"
+#include "hiappevent_base.h"
+#include "hilog/log.h"
+#include "rdb_errno.h"
+#include "sql_util.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D07
+
+#undef LOG_TAG
+#define LOG_TAG "Statement"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace AppEventStatement {
+using namespace AppEventCacheCommon;
+namespace {
+enum EventColumn : size_t {
+    COL_SEQ = 0,
+    COL_DOMAIN,
+    COL_NAME,
+    COL_TYPE,
+    COL_TIME,
+    COL_TZ,
+    COL_PID,
+    COL_TID,
+    COL_TRACE_ID,
+    COL_SPAN_ID,
+    COL_PSPAN_ID,
+    COL_TRACE_FLAG,
+    COL_PARAMS,
+    COL_RUNNING_ID,
+    COL_SIZE,
+    COL_NUM,
+};
+
+// in the order of EventColumn
+constexpr const char* EVENT_COLUMNS[] = {
+    Events::FIELD_SEQ, Events::FIELD_DOMAIN, Events::FIELD_NAME, Events::FIELD_TYPE, Events::FIELD_TIME,
+    Events::FIELD_TZ, Events::FIELD_PID, Events::FIELD_TID, Events::FIELD_TRACE_ID, Events::FIELD_SPAN_ID,
+    Events::FIELD_PSPAN_ID, Events::FIELD_TRACE_FLAG, Events::FIELD_PARAMS, Events::FIELD_RUNNING_ID,
+    Events::FIELD_SIZE,
+};
+static_assert(sizeof(EVENT_COLUMNS) / sizeof(EVENT_COLUMNS[0]) == COL_NUM, "the columns of events are mismatched");
+}
+
+const std::string& InsertEvent()
+{
+    static const std::string sql = SqlUtil::Insert(Events::TABLE, {
+        Events::FIELD_DOMAIN, Events::FIELD_NAME, Events::FIELD_TYPE, Events::FIELD_TIME, Events::FIELD_TZ,
+        Events::FIELD_PID, Events::FIELD_TID, Events::FIELD_TRACE_ID, Events::FIELD_SPAN_ID, Events::FIELD_PSPAN_ID,
+        Events::FIELD_TRACE_FLAG, Events::FIELD_PARAMS, Events::FIELD_RUNNING_ID, Events::FIELD_SIZE,
+    });
+    return sql;
+}
+
+const std::string& QueryEventsOfObserver()
+{
+    static const std::string sql = std::string("SELECT ") + Events::TABLE + ".* FROM " + AppEventMapping::TABLE
+        + " INNER JOIN " + Events::TABLE + " ON " + AppEventMapping::TABLE + "." + AppEventMapping::FIELD_EVENT_SEQ
+        + "=" + Events::TABLE + "." + Events::FIELD_SEQ + " WHERE " + AppEventMapping::FIELD_OBSERVER_SEQ + "=?"
+        + " ORDER BY " + AppEventMapping::TABLE + "." + AppEventMapping::FIELD_EVENT_SEQ + " DESC LIMIT ?";
+    return sql;
+}
+
+const std::string& QueryEventsAfterSeq()
+{
+    static const std::string sql = std::string("SELECT * FROM ") + Events::TABLE + " WHERE " + Events::FIELD_SEQ
+        + ">? ORDER BY " + Events::FIELD_SEQ;
+    return sql;
+}
+
+const std::string& QueryPendingEventsOfObserver()
+{
+    static const std::string sql = std::string("SELECT COUNT(*), SUM(") + Events::TABLE + "." + Events::FIELD_SIZE
+        + ") FROM " + AppEventMapping::TABLE + " INNER JOIN " + Events::TABLE + " ON " + AppEventMapping::TABLE + "."
+        + AppEventMapping::FIELD_EVENT_SEQ + "=" + Events::TABLE + "." + Events::FIELD_SEQ + " WHERE "
+        + AppEventMapping::FIELD_OBSERVER_SEQ + "=?";
+    return sql;
+}
+
+void GetEventBindArgs(std::shared_ptr<AppEventPack> event, int64_t size, std::vector<NativeRdb::ValueObject>& bindArgs)
+{
+    bindArgs = {
+        NativeRdb::ValueObject(event->GetDomain()),
+        NativeRdb::ValueObject(event->GetName()),
+        NativeRdb::ValueObject(event->GetType()),
+        NativeRdb::ValueObject(static_cast<int64_t>(event->GetTime())),
+        NativeRdb::ValueObject(event->GetTimeZone()),
+        NativeRdb::ValueObject(event->GetPid()),
+        NativeRdb::ValueObject(event->GetTid()),
+        NativeRdb::ValueObject(event->GetTraceId()),
+        NativeRdb::ValueObject(event->GetSpanId()),
+        NativeRdb::ValueObject(event->GetPspanId()),
+        NativeRdb::ValueObject(event->GetTraceFlag()),
+        NativeRdb::ValueObject(event->GetParamStr()),
+        NativeRdb::ValueObject(event->GetRunningId()),
+        NativeRdb::ValueObject(size),
+    };
+}
+
+EventRowReader::EventRowReader(std::shared_ptr<NativeRdb::AbsSharedResultSet> resultSet) : resultSet_(resultSet)
+{
+    static_assert(COLUMN_NUM == COL_NUM, "the number of the column indexes is mismatched");
+}
+
+std::shared_ptr<AppEventPack> EventRowReader::Read()
+{
+    CheckColumnIndexes();
+    auto event = std::make_shared<AppEventPack>();
+    event->SetSeq(GetLong(COL_SEQ));
+    event->SetDomain(GetString(COL_DOMAIN));
+    event->SetName(GetString(COL_NAME));
+    event->SetType(static_cast<int>(GetLong(COL_TYPE)));
+    event->SetTime(GetLong(COL_TIME));
+    event->SetTimeZone(GetString(COL_TZ));
+    event->SetPid(static_cast<int>(GetLong(COL_PID)));
+    event->SetTid(static_cast<int>(GetLong(COL_TID)));
+    event->SetTraceId(GetLong(COL_TRACE_ID));
+    event->SetSpanId(GetLong(COL_SPAN_ID));
+    event->SetPspanId(GetLong(COL_PSPAN_ID));
+    event->SetTraceFlag(static_cast<int>(GetLong(COL_TRACE_FLAG)));
+    event->SetParamStr(GetString(COL_PARAMS));
+    event->SetRunningId(GetString(COL_RUNNING_ID));
+    return event;
+}
+
+int64_t EventRowReader::ReadSize()
+{
+    CheckColumnIndexes();
+    return GetLong(COL_SIZE);
+}
+
+void EventRowReader::CheckColumnIndexes()
+{
+    if (!isResolved_) {
+        ResolveColumnIndexes();
+        isResolved_ = true;
+    }
+}
+
+void EventRowReader::ResolveColumnIndexes()
+{
+    for (size_t i = 0; i < COL_NUM; ++i) {
+        if (resultSet_->GetColumnIndex(EVENT_COLUMNS[i], columnIndexes_[i]) != NativeRdb::E_OK) {
+            HILOG_WARN(LOG_CORE, "failed to get column index, colName=%{public}s", EVENT_COLUMNS[i]);
+            columnIndexes_[i] = -1;
+        }
+    }
+}
+
+int64_t EventRowReader::GetLong(size_t column) const
+{
+    int64_t value = 0;
+    if (columnIndexes_[column] >= 0 && resultSet_->GetLong(columnIndexes_[column], value) != NativeRdb::E_OK) {
+        HILOG_WARN(LOG_CORE, "failed to get long value, colName=%{public}s", EVENT_COLUMNS[column]);
+    }
+    return value;
+}
+
+std::string EventRowReader::GetString(size_t column) const
+{
+    std::string value;
+    if (columnIndexes_[column] >= 0 && resultSet_->GetString(columnIndexes_[column], value) != NativeRdb::E_OK) {
+        HILOG_WARN(LOG_CORE, "failed to get string value, colName=%{public}s", EVENT_COLUMNS[column]);
+    }
+    return value;
+}
+} // namespace AppEventStatement
+} // namespace HiviewDFX
+} // namespace OHOS
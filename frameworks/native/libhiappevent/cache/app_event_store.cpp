@@ -14,11 +14,13 @@
  */
 #include "app_event_store.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <utility>
 #include <vector>
 
 #include "app_event_cache_common.h"
+#include "app_event_statement.h"
 #include "app_event_store_callback.h"
 #include "file_util.h"
 #include "hiappevent_base.h"
@@ -42,82 +44,187 @@ namespace HiviewDFX {
 namespace {
 const char* DATABASE_NAME = "appevent.db";
 const char* DATABASE_DIR = "databases/";
+#ifdef APP_EVENT_CURSOR_STORAGE
+constexpr EventStorageMode DEFAULT_STORAGE_MODE = EventStorageMode::CURSOR;
+#else
+constexpr EventStorageMode DEFAULT_STORAGE_MODE = EventStorageMode::MAPPING;
+#endif
 static constexpr size_t MAX_NUM_OF_CUSTOM_PARAMS = 64;
+constexpr size_t MAX_SIZE_OF_CUSTOM_PARAMS_CACHE = 256;
+constexpr int READ_CONNECTION_NUM = 4;
+// the wal is checkpointed passively after the number of the write operations
+constexpr uint32_t WAL_CHECKPOINT_INTERVAL = 500;
+// the max number of the events kept after the min cursor, so that an idle observer does not pin the events forever
+constexpr int MAX_EVENT_NUM_AFTER_CURSOR = 10000;
+constexpr int MAX_EVENT_NUM_OS_AFTER_CURSOR = 1500;
 
-int GetIntFromResultSet(std::shared_ptr<NativeRdb::AbsSharedResultSet> resultSet, const std::string& colName)
+int DeleteHistoryEvents(std::shared_ptr<NativeRdb::RdbStore> dbStore, int reservedNum, int reservedNumOs)
 {
-    int value = 0;
-    int colIndex = 0;
-    if (resultSet->GetColumnIndex(colName, colIndex) != NativeRdb::E_OK) {
-        HILOG_WARN(LOG_CORE, "failed to get column index, colName=%{public}s", colName.c_str());
-        return value;
-    }
-    if (resultSet->GetInt(colIndex, value) != NativeRdb::E_OK) {
-        HILOG_WARN(LOG_CORE, "failed to get int value, colName=%{public}s", colName.c_str());
+    int deleteRows = 0;
+    std::vector<std::string> whereArgs = {
+        DOMAIN_OS, std::to_string(reservedNum), DOMAIN_OS, std::to_string(reservedNumOs)
+    };
+    // delete history events, keep the latest reservedNum events,
+    // and keep the latest reservedNumOs events of OS domain
+    std::string whereClause
+        = std::string(Events::FIELD_SEQ) + " NOT IN (SELECT " + Events::FIELD_SEQ + " FROM " + Events::TABLE
+        + " WHERE " + Events::FIELD_DOMAIN + " != ? ORDER BY "+ Events::FIELD_SEQ + " DESC LIMIT 0,?) AND "
+        + Events::FIELD_SEQ + " NOT IN (SELECT " + Events::FIELD_SEQ + " FROM " + Events::TABLE
+        + " WHERE " + Events::FIELD_DOMAIN + " = ? ORDER BY " + Events::FIELD_SEQ + " DESC LIMIT 0,?)";
+    int ret = dbStore->Delete(deleteRows, Events::TABLE, whereClause, whereArgs);
+    if (ret != NativeRdb::E_OK) {
+        return ret;
     }
-    return value;
+    HILOG_INFO(LOG_CORE, "delete %{public}d events over limit", deleteRows);
+    return DB_SUCC;
 }
 
-int64_t GetLongFromResultSet(std::shared_ptr<NativeRdb::AbsSharedResultSet> resultSet, const std::string& colName)
+std::string GetCustomParamsCacheKey(const std::string& runningId, const std::string& domain, const std::string& name)
 {
-    int64_t value = 0;
-    int colIndex = 0;
-    if (resultSet->GetColumnIndex(colName, colIndex) != NativeRdb::E_OK) {
-        HILOG_WARN(LOG_CORE, "failed to get column index, colName=%{public}s", colName.c_str());
-        return value;
-    }
-    if (resultSet->GetLong(colIndex, value) != NativeRdb::E_OK) {
-        HILOG_WARN(LOG_CORE, "failed to get long value, colName=%{public}s", colName.c_str());
-    }
-    return value;
+    // the domain and the name can not contain ','
+    return runningId + "," + domain + "," + name;
+}
+
+int UpToDbVersion2(NativeRdb::RdbStore& rdbStore)
+{
+    std::string sql = std::string("ALTER TABLE ") + Events::TABLE + " ADD COLUMN "
+        + Events::FIELD_RUNNING_ID + " " + SqlUtil::SQL_TEXT_TYPE + " DEFAULT " + "'';";
+    return rdbStore.ExecuteSql(sql);
+}
+
+int UpToDbVersion3(NativeRdb::RdbStore& rdbStore)
+{
+    std::string sql = std::string("ALTER TABLE ") + Observers::TABLE + " ADD COLUMN "
+        + Observers::FIELD_FILTERS + " " + SqlUtil::SQL_TEXT_TYPE + " DEFAULT " + "'';";
+    return rdbStore.ExecuteSql(sql);
 }
 
-std::string GetStringFromResultSet(std::shared_ptr<NativeRdb::AbsSharedResultSet> resultSet, const std::string& colName)
+int CreateIndexes(NativeRdb::RdbStore& rdbStore)
 {
-    std::string value;
-    int colIndex = 0;
-    if (resultSet->GetColumnIndex(colName, colIndex) != NativeRdb::E_OK) {
-        HILOG_WARN(LOG_CORE, "failed to get column index, colName=%{public}s", colName.c_str());
-        return value;
+    const std::vector<std::string> sqls = {
+        // for querying events of the observer and deleting the mapping records of the events
+        SqlUtil::CreateIndex(AppEventMapping::TABLE, "idx_mapping_observer_event",
+            {AppEventMapping::FIELD_OBSERVER_SEQ, AppEventMapping::FIELD_EVENT_SEQ}),
+        SqlUtil::CreateIndex(AppEventMapping::TABLE, "idx_mapping_event", {AppEventMapping::FIELD_EVENT_SEQ}),
+        // for deleting history events by domain and checking the running ids in use
+        SqlUtil::CreateIndex(Events::TABLE, "idx_events_domain_seq", {Events::FIELD_DOMAIN, Events::FIELD_SEQ}),
+        SqlUtil::CreateIndex(Events::TABLE, "idx_events_running_id", {Events::FIELD_RUNNING_ID}),
+        // for querying the custom params of the event
+        SqlUtil::CreateIndex(CustomEventParams::TABLE, "idx_custom_params_event",
+            {CustomEventParams::FIELD_RUNNING_ID, CustomEventParams::FIELD_DOMAIN, CustomEventParams::FIELD_NAME}),
+    };
+    for (const auto& sql : sqls) {
+        if (int ret = rdbStore.ExecuteSql(sql); ret != NativeRdb::E_OK) {
+            return ret;
+        }
     }
-    if (resultSet->GetString(colIndex, value) != NativeRdb::E_OK) {
-        HILOG_WARN(LOG_CORE, "failed to get string value, colName=%{public}s", colName.c_str());
+    return NativeRdb::E_OK;
+}
+
+int UpToDbVersion4(NativeRdb::RdbStore& rdbStore)
+{
+    return CreateIndexes(rdbStore);
+}
+
+int UpToDbVersion5(NativeRdb::RdbStore& rdbStore)
+{
+    std::string sql = std::string("ALTER TABLE ") + Observers::TABLE + " ADD COLUMN "
+        + Observers::FIELD_CURSOR + " " + SqlUtil::SQL_INT_TYPE + " DEFAULT 0;";
+    return rdbStore.ExecuteSql(sql);
+}
+
+int CreateSizeIndex(NativeRdb::RdbStore& rdbStore)
+{
+    // covers the seq and the size, so the size of the events is summed without reading the params
+    return rdbStore.ExecuteSql(SqlUtil::CreateIndex(Events::TABLE, "idx_events_seq_size",
+        {Events::FIELD_SEQ, Events::FIELD_SIZE}));
+}
+
+void QueryLegacyCustomParams(NativeRdb::RdbStore& rdbStore, std::shared_ptr<AppEventPack> event,
+    std::unordered_map<std::string, std::vector<std::pair<std::string, std::string>>>& paramsCache,
+    std::unordered_map<std::string, std::string>& params)
+{
+    // the same as AppEventStore::QueryCustomParams, the params with event name "" are added first
+    for (const auto& name : {std::string(), event->GetName()}) {
+        std::string key = GetCustomParamsCacheKey(event->GetRunningId(), event->GetDomain(), name);
+        auto it = paramsCache.find(key);
+        if (it == paramsCache.end()) {
+            std::vector<std::pair<std::string, std::string>> newParams;
+            if (CustomEventParamDao::Query(rdbStore, newParams, CustomEvent(event->GetRunningId(),
+                event->GetDomain(), name)) != NativeRdb::E_OK) {
+                newParams.clear();
+            }
+            it = paramsCache.emplace(key, std::move(newParams)).first;
+        }
+        for (const auto& [paramKey, paramValue] : it->second) {
+            params[paramKey] = paramValue;
+        }
     }
-    return value;
 }
 
-std::shared_ptr<AppEventPack> GetEventFromResultSet(std::shared_ptr<NativeRdb::AbsSharedResultSet> resultSet)
+int UpdateLegacyEventSizes(NativeRdb::RdbStore& rdbStore)
 {
-    auto event = std::make_shared<AppEventPack>();
-    event->SetSeq(GetLongFromResultSet(resultSet, Events::FIELD_SEQ));
-    event->SetDomain(GetStringFromResultSet(resultSet, Events::FIELD_DOMAIN));
-    event->SetName(GetStringFromResultSet(resultSet, Events::FIELD_NAME));
-    event->SetType(GetIntFromResultSet(resultSet, Events::FIELD_TYPE));
-    event->SetTime(GetLongFromResultSet(resultSet, Events::FIELD_TIME));
-    event->SetTimeZone(GetStringFromResultSet(resultSet, Events::FIELD_TZ));
-    event->SetPid(GetIntFromResultSet(resultSet, Events::FIELD_PID));
-    event->SetTid(GetIntFromResultSet(resultSet, Events::FIELD_TID));
-    event->SetTraceId(GetLongFromResultSet(resultSet, Events::FIELD_TRACE_ID));
-    event->SetSpanId(GetLongFromResultSet(resultSet, Events::FIELD_SPAN_ID));
-    event->SetPspanId(GetLongFromResultSet(resultSet, Events::FIELD_PSPAN_ID));
-    event->SetTraceFlag(GetIntFromResultSet(resultSet, Events::FIELD_TRACE_FLAG));
-    event->SetParamStr(GetStringFromResultSet(resultSet, Events::FIELD_PARAMS));
-    event->SetRunningId(GetStringFromResultSet(resultSet, Events::FIELD_RUNNING_ID));
-    return event;
+    // the size of the events written before is computed as AppEventStore::GetStoredEventSize does for new events
+    auto resultSet = rdbStore.QuerySql(std::string("SELECT * FROM ") + Events::TABLE);
+    if (resultSet == nullptr) {
+        HILOG_ERROR(LOG_CORE, "failed to query table events");
+        return NativeRdb::E_ERROR;
+    }
+    std::vector<std::pair<int64_t, int64_t>> eventSizes;
+    std::unordered_map<std::string, std::vector<std::pair<std::string, std::string>>> paramsCache;
+    AppEventStatement::EventRowReader reader(resultSet);
+    int ret = NativeRdb::E_OK;
+    while ((ret = resultSet->GoToNextRow()) == NativeRdb::E_OK) {
+        auto event = reader.Read();
+        std::unordered_map<std::string, std::string> params;
+        QueryLegacyCustomParams(rdbStore, event, paramsCache, params);
+        event->AddCustomParams(params);
+        eventSizes.emplace_back(event->GetSeq(), static_cast<int64_t>(event->GetEventSize()));
+    }
+    resultSet->Close();
+    if (ret == NativeRdb::E_SQLITE_CORRUPT) {
+        return ret;
+    }
+    const std::string sql = std::string("UPDATE ") + Events::TABLE + " SET " + Events::FIELD_SIZE + "=? WHERE "
+        + Events::FIELD_SEQ + "=?;";
+    for (const auto& [seq, size] : eventSizes) {
+        if (ret = rdbStore.ExecuteSql(sql, {NativeRdb::ValueObject(size), NativeRdb::ValueObject(seq)});
+            ret != NativeRdb::E_OK) {
+            HILOG_ERROR(LOG_CORE, "failed to update the size of the event, seq=%{public}" PRId64, seq);
+            return ret;
+        }
+    }
+    return NativeRdb::E_OK;
 }
 
-int UpToDbVersion2(NativeRdb::RdbStore& rdbStore)
+int UpToDbVersion6(NativeRdb::RdbStore& rdbStore)
 {
     std::string sql = std::string("ALTER TABLE ") + Events::TABLE + " ADD COLUMN "
-        + Events::FIELD_RUNNING_ID + " " + SqlUtil::SQL_TEXT_TYPE + " DEFAULT " + "'';";
-    return rdbStore.ExecuteSql(sql);
+        + Events::FIELD_SIZE + " " + SqlUtil::SQL_INT_TYPE + " DEFAULT 0;";
+    if (int ret = rdbStore.ExecuteSql(sql); ret != NativeRdb::E_OK) {
+        return ret;
+    }
+    if (int ret = UpdateLegacyEventSizes(rdbStore); ret != NativeRdb::E_OK) {
+        return ret;
+    }
+    return CreateSizeIndex(rdbStore);
 }
 
-int UpToDbVersion3(NativeRdb::RdbStore& rdbStore)
+int UpToDbVersion7(NativeRdb::RdbStore& rdbStore)
 {
-    std::string sql = std::string("ALTER TABLE ") + Observers::TABLE + " ADD COLUMN "
-        + Observers::FIELD_FILTERS + " " + SqlUtil::SQL_TEXT_TYPE + " DEFAULT " + "'';";
-    return rdbStore.ExecuteSql(sql);
+    // the api stats backuped as json are not reported yet, so they are moved to the typed columns
+    std::vector<ApiStatsRecord> records;
+    if (int ret = ApiStatsDao::QueryMetrics(rdbStore, records); ret != NativeRdb::E_OK) {
+        return ret;
+    }
+    std::string sql = std::string("DROP TABLE IF EXISTS ") + ApiStats::TABLE + ";";
+    if (int ret = rdbStore.ExecuteSql(sql); ret != NativeRdb::E_OK) {
+        return ret;
+    }
+    if (int ret = ApiStatsDao::Create(rdbStore); ret != NativeRdb::E_OK) {
+        return ret;
+    }
+    return ApiStatsDao::BatchInsert(rdbStore, records);
 }
 }
 
@@ -152,6 +259,14 @@ int AppEventStoreCallback::OnCreate(NativeRdb::RdbStore& rdbStore)
         HILOG_ERROR(LOG_CORE, "failed to create table api_stats, ret=%{public}d", ret);
         return ret;
     }
+    if (int ret = CreateIndexes(rdbStore); ret != NativeRdb::E_OK) {
+        HILOG_ERROR(LOG_CORE, "failed to create indexes, ret=%{public}d", ret);
+        return ret;
+    }
+    if (int ret = CreateSizeIndex(rdbStore); ret != NativeRdb::E_OK) {
+        HILOG_ERROR(LOG_CORE, "failed to create size index, ret=%{public}d", ret);
+        return ret;
+    }
     return NativeRdb::E_OK;
 }
 
@@ -172,6 +287,30 @@ int AppEventStoreCallback::OnUpgrade(NativeRdb::RdbStore& rdbStore, int oldVersi
                     return ret;
                 }
                 break;
+            case 3: // upgrade db version from 3 to 4
+                if (int ret = UpToDbVersion4(rdbStore); ret != NativeRdb::E_OK) {
+                    HILOG_ERROR(LOG_CORE, "failed to upgrade db version from 3 to 4, ret=%{public}d", ret);
+                    return ret;
+                }
+                break;
+            case 4: // upgrade db version from 4 to 5
+                if (int ret = UpToDbVersion5(rdbStore); ret != NativeRdb::E_OK) {
+                    HILOG_ERROR(LOG_CORE, "failed to upgrade db version from 4 to 5, ret=%{public}d", ret);
+                    return ret;
+                }
+                break;
+            case 5: // upgrade db version from 5 to 6
+                if (int ret = UpToDbVersion6(rdbStore); ret != NativeRdb::E_OK) {
+                    HILOG_ERROR(LOG_CORE, "failed to upgrade db version from 5 to 6, ret=%{public}d", ret);
+                    return ret;
+                }
+                break;
+            case 6: // upgrade db version from 6 to 7
+                if (int ret = UpToDbVersion7(rdbStore); ret != NativeRdb::E_OK) {
+                    HILOG_ERROR(LOG_CORE, "failed to upgrade db version from 6 to 7, ret=%{public}d", ret);
+                    return ret;
+                }
+                break;
             default:
                 break;
         }
@@ -179,8 +318,9 @@ int AppEventStoreCallback::OnUpgrade(NativeRdb::RdbStore& rdbStore, int oldVersi
     return NativeRdb::E_OK;
 }
 
-AppEventStore::AppEventStore()
+AppEventStore::AppEventStore() : storageMode_(DEFAULT_STORAGE_MODE)
 {
+    customParamsCache_ = std::make_shared<const CustomParamsCache>();
     (void)InitDbStore();
 }
 
@@ -204,7 +344,10 @@ int AppEventStore::InitDbStore()
     int ret = NativeRdb::E_OK;
     NativeRdb::RdbStoreConfig config(dirPath_ + DATABASE_NAME);
     config.SetSecurityLevel(NativeRdb::SecurityLevel::S1);
-    const int dbVersion = 3; // 3 means new db version
+    // in wal mode, the queries on the read connections are not blocked by the writer connection
+    config.SetJournalMode(NativeRdb::JournalMode::MODE_WAL);
+    config.SetReadConSize(READ_CONNECTION_NUM);
+    const int dbVersion = 7; // 7 means new db version
     AppEventStoreCallback callback;
     auto dbStore = NativeRdb::RdbHelper::GetRdbStore(config, dbVersion, callback, ret);
     if (ret != NativeRdb::E_OK || dbStore == nullptr) {
@@ -214,6 +357,8 @@ int AppEventStore::InitDbStore()
     }
 
     dbStore_ = dbStore;
+    writeNumSinceCheckpoint_ = 0;
+    ClearCustomParamsCache();
     HILOG_INFO(LOG_CORE, "create db store successfully");
     return DB_SUCC;
 }
@@ -233,40 +378,75 @@ bool AppEventStore::InitDbStoreDir()
     return true;
 }
 
-int AppEventStore::ExecuteDbOperation(const std::function<int()>& func)
+int AppEventStore::ExecuteReadOperation(const std::function<int()>& func)
+{
+    return ExecuteDbOperation(func, false);
+}
+
+int AppEventStore::ExecuteWriteOperation(const std::function<int()>& func)
+{
+    return ExecuteDbOperation(func, true);
+}
+
+int AppEventStore::ExecuteDbOperation(const std::function<int()>& func, bool isWrite)
 {
+    int ret = NativeRdb::E_OK;
     bool isExecuted = false;
-    int OperationRes = ExecuteReadOperation(func, isExecuted);
-    if (OperationRes == DB_SUCC) {
+    {
+        std::shared_lock<std::shared_mutex> lock(dbMutex_);
+        if (dbStore_ != nullptr) {
+            ret = isWrite ? ExecuteByWriter(func) : func();
+            isExecuted = true;
+        }
+    }
+    if (isExecuted && ret == NativeRdb::E_OK) {
         return DB_SUCC;
     }
-    return ExecuteWriteOperation(func, isExecuted, OperationRes);
+
+    // the db store is opened or repaired exclusively
+    std::unique_lock<std::shared_mutex> lock(dbMutex_);
+    if (!isExecuted) {
+        if (dbStore_ == nullptr && InitDbStore() != DB_SUCC) {
+            return DB_FAILED;
+        }
+        ret = func();
+        if (ret == NativeRdb::E_OK) {
+            return DB_SUCC;
+        }
+    }
+    CheckAndRepairDbStore(ret);
+    return DB_FAILED;
 }
 
-int AppEventStore::ExecuteReadOperation(const std::function<int()>& func, bool& isExecuted)
+int AppEventStore::ExecuteByWriter(const std::function<int()>& func)
 {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    if (dbStore_ == nullptr) {
-        return DB_FAILED;
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    int ret = func();
+    if (ret == NativeRdb::E_OK && ++writeNumSinceCheckpoint_ >= WAL_CHECKPOINT_INTERVAL) {
+        writeNumSinceCheckpoint_ = 0;
+        CheckpointWal();
     }
-    isExecuted = true;
-    return func();
+    return ret;
 }
 
-int AppEventStore::ExecuteWriteOperation(const std::function<int()>& func, const bool& isExecuted, int& OperationRes)
+int AppEventStore::CommitTransaction()
 {
-    std::unique_lock<std::shared_mutex> lock(dbMutex_);
-    if (dbStore_ == nullptr && InitDbStore() != DB_SUCC) {
-        return DB_FAILED;
+    int ret = dbStore_->Commit();
+    if (ret != NativeRdb::E_OK) {
+        HILOG_ERROR(LOG_CORE, "failed to commit the transaction, ret=%{public}d", ret);
+        dbStore_->RollBack();
     }
-    if (!isExecuted) {  // opt not execute yet
-        OperationRes = func();
-        if (OperationRes == NativeRdb::E_OK) {
-            return DB_SUCC;
-        }
+    return ret;
+}
+
+void AppEventStore::CheckpointWal(bool isTruncate)
+{
+    // the passive checkpoint neither waits for the readers nor blocks them, but it never shrinks the -wal file,
+    // which is truncated to zero bytes only by the truncating checkpoint
+    const char* sql = isTruncate ? "PRAGMA wal_checkpoint(TRUNCATE)" : "PRAGMA wal_checkpoint(PASSIVE)";
+    if (int ret = dbStore_->ExecuteSql(sql); ret != NativeRdb::E_OK) {
+        HILOG_WARN(LOG_CORE, "failed to checkpoint the wal, isTruncate=%{public}d, ret=%{public}d", isTruncate, ret);
     }
-    CheckAndRepairDbStore(OperationRes);
-    return DB_FAILED;
 }
 
 void AppEventStore::CheckAndRepairDbStore(int errCode)
@@ -275,6 +455,7 @@ void AppEventStore::CheckAndRepairDbStore(int errCode)
         return;
     }
     dbStore_ = nullptr;
+    ClearCustomParamsCache();
     if (int ret = NativeRdb::RdbHelper::DeleteRdbStore(dirPath_ + DATABASE_NAME); ret != NativeRdb::E_OK) {
         HILOG_ERROR(LOG_CORE, "errCode=%{public}d failed to delete db file, ret=%{public}d", errCode, ret);
         return;
@@ -290,6 +471,7 @@ int AppEventStore::DestroyDbStore()
         return DB_SUCC;
     }
     dbStore_ = nullptr;
+    ClearCustomParamsCache();
     if (int ret = NativeRdb::RdbHelper::DeleteRdbStore(dirPath_ + DATABASE_NAME); ret != NativeRdb::E_OK) {
         HILOG_ERROR(LOG_CORE, "failed to destroy db store, ret=%{public}d", ret);
         return DB_FAILED;
@@ -302,21 +484,88 @@ int64_t AppEventStore::InsertEvent(std::shared_ptr<AppEventPack> event)
 {
     int64_t seq = 0;
     auto func = [this, &event, &seq] () {
-        return AppEventDao::Insert(dbStore_, event, seq);
+        return AppEventDao::Insert(dbStore_, event, GetStoredEventSize(event), seq);
     };
-    if (ExecuteDbOperation(func) == DB_FAILED) {
+    if (ExecuteWriteOperation(func) == DB_FAILED) {
         return DB_FAILED;
     }
     return seq;
 }
 
+int AppEventStore::InsertEvents(std::vector<std::shared_ptr<AppEventPack>>& events,
+    const std::vector<std::vector<int64_t>>& observerSeqs)
+{
+    if (events.empty()) {
+        return DB_SUCC;
+    }
+    std::vector<int64_t> seqs;
+    auto func = [this, &events, &observerSeqs, &seqs] () {
+        std::vector<int64_t> sizes;
+        sizes.reserve(events.size());
+        for (const auto& event : events) {
+            sizes.emplace_back(GetStoredEventSize(event));
+        }
+        // commit the events and the mapping records at once instead of one transaction for each row
+        if (int ret = dbStore_->BeginTransaction(); ret != NativeRdb::E_OK) {
+            return ret;
+        }
+        int ret = AppEventDao::BatchInsert(dbStore_, events, sizes, seqs);
+        if (ret == NativeRdb::E_OK && !IsCursorMode()) {
+            std::vector<EventObserverInfo> eventObservers;
+            for (size_t i = 0; i < observerSeqs.size() && i < seqs.size(); ++i) {
+                for (auto observerSeq : observerSeqs[i]) {
+                    eventObservers.emplace_back(seqs[i], observerSeq);
+                }
+            }
+            ret = AppEventMappingDao::BatchInsert(dbStore_, eventObservers);
+        }
+        if (ret != NativeRdb::E_OK) {
+            dbStore_->RollBack();
+            return ret;
+        }
+        return CommitTransaction();
+    };
+    if (ExecuteWriteOperation(func) == DB_FAILED) {
+        HILOG_ERROR(LOG_CORE, "failed to insert events, size=%{public}zu", events.size());
+        return DB_FAILED;
+    }
+    for (size_t i = 0; i < events.size() && i < seqs.size(); ++i) {
+        events[i]->SetSeq(seqs[i]);
+    }
+    return DB_SUCC;
+}
+
+int64_t AppEventStore::GetStoredEventSize(std::shared_ptr<AppEventPack> event)
+{
+    // the custom params are added to the event when it is read, so the stored size contains them as well
+    std::unordered_map<std::string, std::string> params;
+    QueryCustomParams(event, params);
+    if (params.empty()) {
+        return static_cast<int64_t>(event->GetEventSize());
+    }
+    // the event is read back from its params string, so the custom params are added to the string as well
+    AppEventPack storedEvent(*event);
+    storedEvent.SetParamStr(event->GetParamStr());
+    storedEvent.TakeBaseParams();
+    storedEvent.AddCustomParams(params);
+    return static_cast<int64_t>(storedEvent.GetEventSize());
+}
+
 int64_t AppEventStore::InsertObserver(const Observer& observer)
 {
     int64_t seq = 0;
     auto func = [this, &observer, &seq] () {
-        return AppEventObserverDao::Insert(dbStore_, observer, seq);
+        if (!IsCursorMode()) {
+            return AppEventObserverDao::Insert(dbStore_, observer, seq);
+        }
+        // the new observer only receives the events written after it is added
+        Observer newObserver = observer;
+        if (int ret = AppEventDao::QueryMaxSeq(dbStore_, newObserver.cursor); ret != NativeRdb::E_OK) {
+            return ret;
+        }
+        return AppEventObserverDao::Insert(dbStore_, newObserver, seq);
     };
-    if (ExecuteDbOperation(func) == DB_FAILED) {
+    if (ExecuteWriteOperation(func) == DB_FAILED) {
         return DB_FAILED;
     }
     return seq;
@@ -324,10 +573,13 @@ int64_t AppEventStore::InsertObserver(const Observer& observer)
 
 int AppEventStore::InsertEventMapping(const std::vector<EventObserverInfo>& eventObservers)
 {
+    if (IsCursorMode()) {
+        return DB_SUCC;
+    }
     auto func = [this, &eventObservers] () {
         return AppEventMappingDao::Insert(dbStore_, eventObservers);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteWriteOperation(func);
 }
 
 int AppEventStore::InsertUserId(const std::string& name, const std::string& value)
@@ -335,7 +587,7 @@ int AppEventStore::InsertUserId(const std::string& name, const std::string& valu
     auto func = [this, &name, &value] () {
         return UserIdDao::Insert(dbStore_, name, value);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteWriteOperation(func);
 }
 
 int AppEventStore::InsertUserProperty(const std::string& name, const std::string& value)
@@ -343,16 +595,26 @@ int AppEventStore::InsertUserProperty(const std::string& name, const std::string
     auto func = [this, &name, &value] () {
         return UserPropertyDao::Insert(dbStore_, name, value);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteWriteOperation(func);
 }
 
-int AppEventStore::InsertApiMetricInfo(const std::string& kitName, const std::string& apiName,
-    const std::string& metricJson)
+int AppEventStore::InsertApiStats(const std::vector<ApiStatsRecord>& records)
 {
-    auto func = [this, &kitName, &apiName, &metricJson] () {
-        return ApiStatsDao::MetricInsert(dbStore_, kitName, apiName, metricJson);
+    if (records.empty()) {
+        return DB_SUCC;
+    }
+    auto func = [this, &records] () {
+        // commit the records of all the apis at once instead of one transaction for each row
+        if (int ret = dbStore_->BeginTransaction(); ret != NativeRdb::E_OK) {
+            return ret;
+        }
+        if (int ret = ApiStatsDao::BatchInsert(dbStore_, records); ret != NativeRdb::E_OK) {
+            dbStore_->RollBack();
+            return ret;
+        }
+        return CommitTransaction();
     };
-    return ExecuteDbOperation(func);
+    return ExecuteWriteOperation(func);
 }
 
 int AppEventStore::InsertCustomEventParams(std::shared_ptr<AppEventPack> event)
@@ -402,7 +664,8 @@ int AppEventStore::InsertCustomEventParams(std::shared_ptr<AppEventPack> event)
         dbStore_->Commit();
         return DB_SUCC;
     };
-    int res = ExecuteDbOperation(func);
+    int res = ExecuteWriteOperation(func);
+    ClearCustomParamsCache();
     HILOG_INFO(LOG_CORE, "the event(%{public}s) current runningId is %{public}s, add %{public}zu custom params, "
         "ret=%{public}d", event->GetName().c_str(), event->GetRunningId().c_str(), newParams.size(), res);
     return errCode != DB_SUCC ? errCode : res;
@@ -413,7 +676,7 @@ int AppEventStore::UpdateUserId(const std::string& name, const std::string& valu
     auto func = [this, &name, &value] () {
         return UserIdDao::Update(dbStore_, name, value);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteWriteOperation(func);
 }
 
 int AppEventStore::UpdateUserProperty(const std::string& name, const std::string& value)
@@ -421,7 +684,7 @@ int AppEventStore::UpdateUserProperty(const std::string& name, const std::string
     auto func = [this, &name, &value] () {
         return UserPropertyDao::Update(dbStore_, name, value);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteWriteOperation(func);
 }
 
 int AppEventStore::UpdateObserver(int64_t seq, const std::string& filters)
@@ -429,7 +692,7 @@ int AppEventStore::UpdateObserver(int64_t seq, const std::string& filters)
     auto func = [this, &seq, &filters] () {
         return AppEventObserverDao::Update(dbStore_, seq, filters);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteWriteOperation(func);
 }
 
 int AppEventStore::DeleteUserId(const std::string& name)
@@ -437,7 +700,7 @@ int AppEventStore::DeleteUserId(const std::string& name)
     auto func = [this, &name] () {
         return UserIdDao::Delete(dbStore_, name);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteWriteOperation(func);
 }
 
 int AppEventStore::DeleteUserProperty(const std::string& name)
@@ -445,15 +708,15 @@ int AppEventStore::DeleteUserProperty(const std::string& name)
     auto func = [this, &name] () {
         return UserPropertyDao::Delete(dbStore_, name);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteWriteOperation(func);
 }
 
-int AppEventStore::ClearApiMetricInfo()
+int AppEventStore::ClearApiStats()
 {
     auto func = [this] () {
-        return ApiStatsDao::MetricClear(dbStore_);
+        return ApiStatsDao::Clear(dbStore_);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteWriteOperation(func);
 }
 
 int AppEventStore::QueryUserIds(std::unordered_map<std::string, std::string>& out)
@@ -461,7 +724,7 @@ int AppEventStore::QueryUserIds(std::unordered_map<std::string, std::string>& ou
     auto func = [this, &out] () {
         return UserIdDao::QueryAll(dbStore_, out);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteReadOperation(func);
 }
 
 int AppEventStore::QueryUserId(const std::string& name, std::string& out)
@@ -469,7 +732,7 @@ int AppEventStore::QueryUserId(const std::string& name, std::string& out)
     auto func = [this, &name, &out] () {
         return UserIdDao::Query(dbStore_, name, out);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteReadOperation(func);
 }
 
 int AppEventStore::QueryUserProperties(std::unordered_map<std::string, std::string>& out)
@@ -477,7 +740,7 @@ int AppEventStore::QueryUserProperties(std::unordered_map<std::string, std::stri
     auto func = [this, &out] () {
         return UserPropertyDao::QueryAll(dbStore_, out);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteReadOperation(func);
 }
 
 int AppEventStore::QueryUserProperty(const std::string& name, std::string& out)
@@ -485,15 +748,41 @@ int AppEventStore::QueryUserProperty(const std::string& name, std::string& out)
     auto func = [this, &name, &out] () {
         return UserPropertyDao::Query(dbStore_, name, out);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteReadOperation(func);
 }
 
-int AppEventStore::QueryApiMetricInfoAll(std::map<std::pair<std::string, std::string>, std::vector<std::string>>& out)
+int AppEventStore::QueryApiStats(std::vector<ApiStatsRecord>& records)
 {
-    auto func = [this, &out] () {
-        return ApiStatsDao::MetricQueryAll(dbStore_, out);
+    auto func = [this, &records] () {
+        return ApiStatsDao::QueryAggregated(dbStore_, records);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteReadOperation(func);
+}
+
+int AppEventStore::TakeApiStats(std::vector<ApiStatsRecord>& records)
+{
+    auto func = [this, &records] () {
+        // no record is backuped between the query and the deletion, since the writes are serialized
+        if (int ret = dbStore_->BeginTransaction(); ret != NativeRdb::E_OK) {
+            return ret;
+        }
+        int ret = ApiStatsDao::QueryAggregated(dbStore_, records);
+        if (ret == NativeRdb::E_OK) {
+            ret = ApiStatsDao::Clear(dbStore_);
+        }
+        if (ret != NativeRdb::E_OK) {
+            dbStore_->RollBack();
+            records.clear();
+            return ret;
+        }
+        // the records are kept in the db if the deletion is rolled back, so they are reported next time
+        if (int ret = CommitTransaction(); ret != NativeRdb::E_OK) {
+            records.clear();
+            return ret;
+        }
+        return NativeRdb::E_OK;
+    };
+    return ExecuteWriteOperation(func);
 }
 
 int AppEventStore::TakeEvents(std::vector<std::shared_ptr<AppEventPack>>& events, int64_t observerSeq, uint32_t size)
@@ -510,6 +799,10 @@ int AppEventStore::TakeEvents(std::vector<std::shared_ptr<AppEventPack>>& events
     for (const auto &event : events) {
         eventSeqs.emplace_back(event->GetSeq());
     }
+    if (IsCursorMode()) {
+        // the taken events are consumed by moving the cursor of the observer
+        return MoveCursor(observerSeq, eventSeqs);
+    }
 
     auto func = [this, &observerSeq, &eventSeqs] () {
         int ret = AppEventMappingDao::Delete(dbStore_, observerSeq, eventSeqs);
@@ -519,55 +812,326 @@ int AppEventStore::TakeEvents(std::vector<std::shared_ptr<AppEventPack>>& events
         }
         return ret;
     };
-    return ExecuteDbOperation(func);
+    return ExecuteWriteOperation(func);
 }
 
 int AppEventStore::QueryEvents(std::vector<std::shared_ptr<AppEventPack>>& events, int64_t observerSeq, uint32_t size)
 {
-    auto func = [this, &events, &observerSeq, &size] () {
-        std::shared_ptr<NativeRdb::AbsSharedResultSet> resultSet = nullptr;
-        std::string sql = std::string("SELECT ") + Events::TABLE + ".* FROM " + AppEventMapping::TABLE + " INNER JOIN "
-            + Events::TABLE + " ON " + AppEventMapping::TABLE + "." + AppEventMapping::FIELD_EVENT_SEQ + "="
-            + Events::TABLE + "." + Events::FIELD_SEQ + " WHERE " + AppEventMapping::FIELD_OBSERVER_SEQ + "=?"
-            + " ORDER BY " + AppEventMapping::TABLE + "." + AppEventMapping::FIELD_EVENT_SEQ + " DESC ";
-        if (size > 0) {
-            sql += " LIMIT " + std::to_string(size);
+    EventQueryLimit limit;
+    limit.row = size;
+    return QueryEventsWithLimit(events, observerSeq, limit);
+}
+
+int AppEventStore::QueryEventsBySize(std::vector<std::shared_ptr<AppEventPack>>& events, int64_t observerSeq,
+    size_t maxSize)
+{
+    if (maxSize == 0) {
+        return DB_SUCC;
+    }
+    EventQueryLimit limit;
+    limit.size = maxSize;
+    return QueryEventsWithLimit(events, observerSeq, limit);
+}
+
+int AppEventStore::QueryEventsWithLimit(std::vector<std::shared_ptr<AppEventPack>>& events, int64_t observerSeq,
+    const EventQueryLimit& limit)
+{
+    if (IsCursorMode()) {
+        return QueryEventsAfterCursor(events, observerSeq, limit);
+    }
+    auto func = [this, &events, &observerSeq, &limit] () {
+        // the limit is also bound, so the same statement is used whether the row is specified or not
+        std::vector<NativeRdb::ValueObject> bindArgs = {
+            NativeRdb::ValueObject(observerSeq),
+            NativeRdb::ValueObject(limit.row > 0 ? static_cast<int64_t>(limit.row) : static_cast<int64_t>(-1)),
+        };
+        auto resultSet = dbStore_->QuerySql(AppEventStatement::QueryEventsOfObserver(), bindArgs);
+        if (resultSet == nullptr) {
+            HILOG_WARN(LOG_CORE, "result set is null, observer=%{public}" PRId64, observerSeq);
+            return DB_FAILED;
         }
-        resultSet = dbStore_->QuerySql(sql, std::vector<std::string>{std::to_string(observerSeq)});
+        return ReadEvents(resultSet, nullptr, limit, events);
+    };
+    return ExecuteReadOperation(func);
+}
+
+int AppEventStore::QueryEventsAfterCursor(std::vector<std::shared_ptr<AppEventPack>>& events, int64_t observerSeq,
+    const EventQueryLimit& limit)
+{
+    auto filter = GetPendingEventFilter(observerSeq);
+    if (filter == nullptr) {
+        HILOG_WARN(LOG_CORE, "the filter of observer=%{public}" PRId64 " is not set", observerSeq);
+        return DB_SUCC;
+    }
+    auto func = [this, &events, &observerSeq, &limit, &filter] () {
+        int64_t cursor = 0;
+        if (int ret = AppEventObserverDao::QueryCursor(dbStore_, observerSeq, cursor); ret != NativeRdb::E_OK) {
+            return ret;
+        }
+        std::vector<NativeRdb::ValueObject> bindArgs = { NativeRdb::ValueObject(cursor) };
+        auto resultSet = dbStore_->QuerySql(AppEventStatement::QueryEventsAfterSeq(), bindArgs);
+        if (resultSet == nullptr) {
+            HILOG_WARN(LOG_CORE, "result set is null, observer=%{public}" PRId64, observerSeq);
+            return DB_FAILED;
+        }
+        return ReadEvents(resultSet, filter, limit, events);
+    };
+    return ExecuteReadOperation(func);
+}
+
+int AppEventStore::QueryPendingEvents(int64_t observerSeq, int64_t& row, int64_t& size)
+{
+    row = 0;
+    size = 0;
+    if (IsCursorMode()) {
+        return QueryPendingEventsAfterCursor(observerSeq, row, size);
+    }
+    auto func = [this, &observerSeq, &row, &size] () {
+        std::vector<NativeRdb::ValueObject> bindArgs = { NativeRdb::ValueObject(observerSeq) };
+        auto resultSet = dbStore_->QuerySql(AppEventStatement::QueryPendingEventsOfObserver(), bindArgs);
         if (resultSet == nullptr) {
             HILOG_WARN(LOG_CORE, "result set is null, observer=%{public}" PRId64, observerSeq);
             return DB_FAILED;
         }
         int ret = resultSet->GoToNextRow();
+        if (ret == NativeRdb::E_OK) {
+            // the sum is null if there is no event, then the size is not changed
+            (void)resultSet->GetLong(0, row);
+            (void)resultSet->GetLong(1, size);
+        }
+        resultSet->Close();
+        return ret == NativeRdb::E_SQLITE_CORRUPT ? ret : DB_SUCC;
+    };
+    return ExecuteReadOperation(func);
+}
+
+int AppEventStore::QueryPendingEventsAfterCursor(int64_t observerSeq, int64_t& row, int64_t& size)
+{
+    auto filter = GetPendingEventFilter(observerSeq);
+    if (filter == nullptr) {
+        HILOG_WARN(LOG_CORE, "the filter of observer=%{public}" PRId64 " is not set", observerSeq);
+        return DB_SUCC;
+    }
+    auto func = [this, &observerSeq, &row, &size, &filter] () {
+        int64_t cursor = 0;
+        if (int ret = AppEventObserverDao::QueryCursor(dbStore_, observerSeq, cursor); ret != NativeRdb::E_OK) {
+            return ret;
+        }
+        std::vector<NativeRdb::ValueObject> bindArgs = { NativeRdb::ValueObject(cursor) };
+        auto resultSet = dbStore_->QuerySql(AppEventStatement::QueryEventsAfterSeq(), bindArgs);
+        if (resultSet == nullptr) {
+            HILOG_WARN(LOG_CORE, "result set is null, observer=%{public}" PRId64, observerSeq);
+            return DB_FAILED;
+        }
+        // the filters can not be matched by sql, but the events are neither serialized nor added the custom params
+        AppEventStatement::EventRowReader reader(resultSet);
+        int ret = resultSet->GoToNextRow();
         while (ret == NativeRdb::E_OK) {
-            auto event = GetEventFromResultSet(resultSet);
+            if (filter(reader.Read())) {
+                ++row;
+                size += reader.ReadSize();
+            }
+            ret = resultSet->GoToNextRow();
+        }
+        resultSet->Close();
+        return ret == NativeRdb::E_SQLITE_CORRUPT ? ret : DB_SUCC;
+    };
+    return ExecuteReadOperation(func);
+}
+
+int AppEventStore::ReadEvents(std::shared_ptr<NativeRdb::AbsSharedResultSet> resultSet, const EventFilter& filter,
+    const EventQueryLimit& limit, std::vector<std::shared_ptr<AppEventPack>>& events)
+{
+    // the rows are read one by one, so the rows after the limit is reached are never read
+    AppEventStatement::EventRowReader reader(resultSet);
+    size_t totalSize = 0;
+    int ret = resultSet->GoToNextRow();
+    while (ret == NativeRdb::E_OK && (limit.row == 0 || events.size() < limit.row)) {
+        auto event = reader.Read();
+        if (filter == nullptr || filter(event)) {
             // query custom event params, and add to AppEventPack
             std::unordered_map<std::string, std::string> params;
-            // event name is not mandatory, query custom event params with event name is "" first
-            CustomEventParamDao::Query(dbStore_, params, CustomEvent(event->GetRunningId(), event->GetDomain(), ""));
-            CustomEventParamDao::Query(dbStore_, params,
-                CustomEvent(event->GetRunningId(), event->GetDomain(), event->GetName()));
+            QueryCustomParams(event, params);
             event->AddCustomParams(params);
+            if (limit.size > 0) {
+                // the serialized event is cached, so it is not serialized again when the event is taken
+                totalSize += event->GetEventSize();
+                if (totalSize > limit.size) {
+                    HILOG_INFO(LOG_CORE, "stop to read events, num=%{public}zu, maxSize=%{public}zu",
+                        events.size(), limit.size);
+                    break;
+                }
+            }
             events.emplace_back(event);
-            ret = resultSet->GoToNextRow();
         }
-        resultSet->Close();
-        if (ret == NativeRdb::E_SQLITE_CORRUPT) {
+        ret = resultSet->GoToNextRow();
+    }
+    resultSet->Close();
+    if (ret == NativeRdb::E_SQLITE_CORRUPT) {
+        return ret;
+    }
+    return DB_SUCC;
+}
+
+int AppEventStore::MoveCursor(int64_t observerSeq, const std::vector<int64_t>& eventSeqs)
+{
+    if (observerSeq <= 0) {
+        // the cursors are kept when all the events are cleared, since the seqs of the events are not reused
+        return DB_SUCC;
+    }
+    if (eventSeqs.empty()) {
+        // all the pending events of the observer are consumed
+        auto func = [this, &observerSeq] () {
+            int64_t cursor = 0;
+            if (int ret = AppEventDao::QueryMaxSeq(dbStore_, cursor); ret != NativeRdb::E_OK) {
+                return ret;
+            }
+            return AppEventObserverDao::UpdateCursor(dbStore_, observerSeq, cursor);
+        };
+        int ret = ExecuteWriteOperation(func);
+        std::lock_guard<std::mutex> lock(filtersMutex_);
+        ackedSeqs_.erase(observerSeq);
+        return ret;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(filtersMutex_);
+        ackedSeqs_[observerSeq].insert(eventSeqs.begin(), eventSeqs.end());
+    }
+    auto filter = GetEventFilter(observerSeq);
+    auto func = [this, &observerSeq, &filter] () {
+        int64_t cursor = 0;
+        if (int ret = AppEventObserverDao::QueryCursor(dbStore_, observerSeq, cursor); ret != NativeRdb::E_OK) {
             return ret;
         }
-        return DB_SUCC;
+        int64_t newCursor = 0;
+        if (int ret = QueryConsumedCursor(observerSeq, cursor, filter, newCursor); ret != NativeRdb::E_OK) {
+            return ret;
+        }
+        if (newCursor > cursor) {
+            if (int ret = AppEventObserverDao::UpdateCursor(dbStore_, observerSeq, newCursor); ret != NativeRdb::E_OK) {
+                return ret;
+            }
+        }
+        // the cursor is updated before the acked seqs behind it are removed, see GetPendingEventFilter
+        std::lock_guard<std::mutex> lock(filtersMutex_);
+        if (auto it = ackedSeqs_.find(observerSeq); it != ackedSeqs_.end()) {
+            it->second.erase(it->second.begin(), it->second.upper_bound(newCursor));
+        }
+        return NativeRdb::E_OK;
+    };
+    return ExecuteWriteOperation(func);
+}
+
+int AppEventStore::QueryConsumedCursor(int64_t observerSeq, int64_t cursor, const EventFilter& filter,
+    int64_t& newCursor)
+{
+    newCursor = cursor;
+    std::set<int64_t> ackedSeqs = GetAckedSeqs(observerSeq);
+    std::vector<NativeRdb::ValueObject> bindArgs = { NativeRdb::ValueObject(cursor) };
+    auto resultSet = dbStore_->QuerySql(AppEventStatement::QueryEventsAfterSeq(), bindArgs);
+    if (resultSet == nullptr) {
+        HILOG_WARN(LOG_CORE, "result set is null, observer=%{public}" PRId64, observerSeq);
+        return DB_FAILED;
+    }
+    // the cursor only moves over the consumed prefix of the pending events, so the events acked out of order wait
+    // for the events before them to be acked
+    AppEventStatement::EventRowReader reader(resultSet);
+    int ret = resultSet->GoToNextRow();
+    while (ret == NativeRdb::E_OK && !ackedSeqs.empty() && newCursor < *ackedSeqs.rbegin()) {
+        auto event = reader.Read();
+        if (ackedSeqs.find(event->GetSeq()) == ackedSeqs.end() && (filter == nullptr || filter(event))) {
+            break;
+        }
+        newCursor = event->GetSeq();
+        ret = resultSet->GoToNextRow();
+    }
+    resultSet->Close();
+    return ret == NativeRdb::E_SQLITE_CORRUPT ? ret : NativeRdb::E_OK;
+}
+
+int AppEventStore::DeleteEventsBehindCursor(const std::vector<int64_t>& eventSeqs)
+{
+    auto func = [this, &eventSeqs] () {
+        int64_t minCursor = 0;
+        bool isExist = false;
+        if (int ret = AppEventObserverDao::QueryMinCursor(dbStore_, minCursor, isExist); ret != NativeRdb::E_OK) {
+            return ret;
+        }
+        if (!isExist) {
+            // no observer is waiting for the events
+            minCursor = *std::max_element(eventSeqs.begin(), eventSeqs.end());
+        }
+        if (int ret = AppEventDao::DeleteBefore(dbStore_, minCursor); ret != NativeRdb::E_OK) {
+            return ret;
+        }
+        // an idle observer pins the events after its cursor, so the history events are trimmed as the cleaner does
+        int64_t maxSeq = 0;
+        if (int ret = AppEventDao::QueryMaxSeq(dbStore_, maxSeq); ret != NativeRdb::E_OK) {
+            return ret;
+        }
+        if (maxSeq - minCursor <= MAX_EVENT_NUM_AFTER_CURSOR) {
+            return NativeRdb::E_OK;
+        }
+        return DeleteHistoryEvents(dbStore_, MAX_EVENT_NUM_AFTER_CURSOR, MAX_EVENT_NUM_OS_AFTER_CURSOR);
+    };
+    return ExecuteWriteOperation(func);
+}
+
+void AppEventStore::SetStorageMode(EventStorageMode mode)
+{
+    HILOG_INFO(LOG_CORE, "set storage mode=%{public}d", static_cast<int>(mode));
+    storageMode_ = mode;
+}
+
+EventStorageMode AppEventStore::GetStorageMode() const
+{
+    return storageMode_;
+}
+
+bool AppEventStore::IsCursorMode() const
+{
+    return storageMode_ == EventStorageMode::CURSOR;
+}
+
+void AppEventStore::SetEventFilter(int64_t observerSeq, EventFilter filter)
+{
+    std::lock_guard<std::mutex> lock(filtersMutex_);
+    eventFilters_[observerSeq] = std::move(filter);
+}
+
+std::set<int64_t> AppEventStore::GetAckedSeqs(int64_t observerSeq)
+{
+    std::lock_guard<std::mutex> lock(filtersMutex_);
+    auto it = ackedSeqs_.find(observerSeq);
+    return it != ackedSeqs_.end() ? it->second : std::set<int64_t>();
+}
+
+AppEventStore::EventFilter AppEventStore::GetPendingEventFilter(int64_t observerSeq)
+{
+    auto filter = GetEventFilter(observerSeq);
+    // the acked seqs are got before the cursor is queried, so an acked event is never regarded as pending
+    auto ackedSeqs = GetAckedSeqs(observerSeq);
+    if (filter == nullptr || ackedSeqs.empty()) {
+        return filter;
+    }
+    return [filter, ackedSeqs = std::move(ackedSeqs)] (std::shared_ptr<AppEventPack> event) {
+        return ackedSeqs.find(event->GetSeq()) == ackedSeqs.end() && filter(event);
     };
-    return ExecuteDbOperation(func);
+}
+
+AppEventStore::EventFilter AppEventStore::GetEventFilter(int64_t observerSeq)
+{
+    std::lock_guard<std::mutex> lock(filtersMutex_);
+    auto it = eventFilters_.find(observerSeq);
+    return it == eventFilters_.end() ? nullptr : it->second;
 }
 
 int AppEventStore::QueryCustomParamsAdd2EventPack(std::shared_ptr<AppEventPack> event)
 {
     auto func = [this, &event] () {
         std::unordered_map<std::string, std::string> params;
-        // event name is not mandatory, query custom event params with event name is "" first
-        CustomEventParamDao::Query(dbStore_, params, CustomEvent(event->GetRunningId(), event->GetDomain(), ""));
-        CustomEventParamDao::Query(dbStore_, params,
-            CustomEvent(event->GetRunningId(), event->GetDomain(), event->GetName()));
+        QueryCustomParams(event, params);
         if (params.empty() && event->GetDomain() != "api_diagnostic") {
             HILOG_WARN(LOG_CORE, "the event(%{public}s) current runningId is %{public}s, the custom param is empty.",
                 event->GetName().c_str(), event->GetRunningId().c_str());
@@ -575,7 +1139,52 @@ int AppEventStore::QueryCustomParamsAdd2EventPack(std::shared_ptr<AppEventPack>
         event->AddCustomParams(params);
         return DB_SUCC;
     };
-    return ExecuteDbOperation(func);
+    return ExecuteReadOperation(func);
+}
+
+void AppEventStore::QueryCustomParams(std::shared_ptr<AppEventPack> event,
+    std::unordered_map<std::string, std::string>& params)
+{
+    auto cache = std::atomic_load(&customParamsCache_);
+    // event name is not mandatory, query custom event params with event name is "" first
+    for (const auto& name : {std::string(), event->GetName()}) {
+        std::string key = GetCustomParamsCacheKey(event->GetRunningId(), event->GetDomain(), name);
+        auto it = cache->params.find(key);
+        if (it != cache->params.end()) {
+            for (const auto& [paramKey, paramValue] : it->second) {
+                params[paramKey] = paramValue;
+            }
+            continue;
+        }
+        std::vector<std::pair<std::string, std::string>> newParams;
+        if (CustomEventParamDao::Query(dbStore_, newParams, CustomEvent(event->GetRunningId(), event->GetDomain(),
+            name)) != NativeRdb::E_OK) {
+            continue;
+        }
+        for (const auto& [paramKey, paramValue] : newParams) {
+            params[paramKey] = paramValue;
+        }
+        auto newCache = std::make_shared<CustomParamsCache>(*cache);
+        if (newCache->params.size() >= MAX_SIZE_OF_CUSTOM_PARAMS_CACHE && !newCache->keys.empty()) {
+            newCache->params.erase(newCache->keys.front());
+            newCache->keys.pop_front();
+        }
+        newCache->keys.emplace_back(key);
+        newCache->params.emplace(key, std::move(newParams));
+        // discard the result if the params are changed during the query
+        std::shared_ptr<const CustomParamsCache> expected = cache;
+        if (std::atomic_compare_exchange_strong(&customParamsCache_, &expected,
+            std::shared_ptr<const CustomParamsCache>(newCache))) {
+            cache = newCache;
+        } else {
+            cache = expected;
+        }
+    }
+}
+
+void AppEventStore::ClearCustomParamsCache()
+{
+    std::atomic_store(&customParamsCache_, std::make_shared<const CustomParamsCache>());
 }
 
 int64_t AppEventStore::QueryObserverSeq(const std::string& name, int64_t hashCode)
@@ -590,7 +1199,7 @@ int64_t AppEventStore::QueryObserverSeqAndFilters(const std::string& name, int64
     auto func = [this, &name, &hashCode, &seq, &filters] () {
         return AppEventObserverDao::QuerySeqAndFilters(dbStore_, Observer(name, hashCode), seq, filters);
     };
-    if (ExecuteDbOperation(func) == DB_FAILED) {
+    if (ExecuteReadOperation(func) == DB_FAILED) {
         return DB_FAILED;
     }
     return seq;
@@ -601,7 +1210,7 @@ int AppEventStore::QueryObserverSeqs(const std::string& name, std::vector<int64_
     auto func = [this, &name, &observerSeqs] () {
         return AppEventObserverDao::QuerySeqs(dbStore_, name, observerSeqs);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteReadOperation(func);
 }
 
 int AppEventStore::QueryWatchers(std::vector<Observer>& observers)
@@ -609,11 +1218,16 @@ int AppEventStore::QueryWatchers(std::vector<Observer>& observers)
     auto func = [this, &observers] () {
         return AppEventObserverDao::QueryWatchers(dbStore_, observers);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteReadOperation(func);
 }
 
 int AppEventStore::DeleteObserver(int64_t observerSeq)
 {
+    {
+        std::lock_guard<std::mutex> lock(filtersMutex_);
+        eventFilters_.erase(observerSeq);
+        ackedSeqs_.erase(observerSeq);
+    }
     auto func = [this, &observerSeq] () {
         int retM = AppEventMappingDao::Delete(dbStore_, observerSeq, {});
         if (retM != NativeRdb::E_OK) {
@@ -621,15 +1235,18 @@ int AppEventStore::DeleteObserver(int64_t observerSeq)
         }
         return AppEventObserverDao::Delete(dbStore_, observerSeq);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteWriteOperation(func);
 }
 
 int AppEventStore::DeleteEventMapping(int64_t observerSeq, const std::vector<int64_t>& eventSeqs)
 {
+    if (IsCursorMode()) {
+        return MoveCursor(observerSeq, eventSeqs);
+    }
     auto func = [this, &observerSeq, &eventSeqs] () {
         return AppEventMappingDao::Delete(dbStore_, observerSeq, eventSeqs);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteWriteOperation(func);
 }
 
 int AppEventStore::DeleteEvent(int64_t eventSeq)
@@ -637,7 +1254,7 @@ int AppEventStore::DeleteEvent(int64_t eventSeq)
     auto func = [this, &eventSeq] () {
         return AppEventDao::Delete(dbStore_, eventSeq);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteWriteOperation(func);
 }
 
 int AppEventStore::DeleteCustomEventParams()
@@ -645,7 +1262,9 @@ int AppEventStore::DeleteCustomEventParams()
     auto func = [this] () {
         return CustomEventParamDao::Delete(dbStore_);
     };
-    return ExecuteDbOperation(func);
+    int ret = ExecuteWriteOperation(func);
+    ClearCustomParamsCache();
+    return ret;
 }
 
 int AppEventStore::DeleteEvent(const std::vector<int64_t>& eventSeqs)
@@ -653,6 +1272,9 @@ int AppEventStore::DeleteEvent(const std::vector<int64_t>& eventSeqs)
     if (eventSeqs.empty()) {
         return DB_SUCC;
     }
+    if (IsCursorMode()) {
+        return DeleteEventsBehindCursor(eventSeqs);
+    }
     auto func = [this, &eventSeqs] () {
         std::unordered_set<int64_t> existEventSeqs;
         // query seqs in event_observer_mapping
@@ -669,7 +1291,7 @@ int AppEventStore::DeleteEvent(const std::vector<int64_t>& eventSeqs)
         }
         return AppEventDao::Delete(dbStore_, delEventSeqs);
     };
-    return ExecuteDbOperation(func);
+    return ExecuteWriteOperation(func);
 }
 
 int AppEventStore::DeleteUnusedParamsExceptCurId(const std::string& curRunningId)
@@ -717,7 +1339,9 @@ int AppEventStore::DeleteUnusedParamsExceptCurId(const std::string& curRunningId
         HILOG_INFO(LOG_CORE, "delete %{public}d params unused", deleteRows);
         return DB_SUCC;
     };
-    return ExecuteDbOperation(func);
+    int ret = ExecuteWriteOperation(func);
+    ClearCustomParamsCache();
+    return ret;
 }
 
 int AppEventStore::DeleteUnusedEventMapping()
@@ -734,31 +1358,21 @@ int AppEventStore::DeleteUnusedEventMapping()
         HILOG_INFO(LOG_CORE, "delete %{public}d event map unused", deleteRows);
         return DB_SUCC;
     };
-    return ExecuteDbOperation(func);
+    return ExecuteWriteOperation(func);
 }
 
 int AppEventStore::DeleteHistoryEvent(int reservedNum, int reservedNumOs)
 {
     auto func = [this, &reservedNum, &reservedNumOs] () {
-        int deleteRows = 0;
-        std::vector<std::string> whereArgs = {
-            DOMAIN_OS, std::to_string(reservedNum), DOMAIN_OS, std::to_string(reservedNumOs)
-        };
-        // delete history events, keep the latest reservedNum events,
-        // and keep the latest reservedNumOs events of OS domain
-        std::string whereClause
-            = std::string(Events::FIELD_SEQ) + " NOT IN (SELECT " + Events::FIELD_SEQ + " FROM " + Events::TABLE
-            + " WHERE " + Events::FIELD_DOMAIN + " != ? ORDER BY "+ Events::FIELD_SEQ + " DESC LIMIT 0,?) AND "
-            + Events::FIELD_SEQ + " NOT IN (SELECT " + Events::FIELD_SEQ + " FROM " + Events::TABLE
-            + " WHERE " + Events::FIELD_DOMAIN + " = ? ORDER BY " + Events::FIELD_SEQ + " DESC LIMIT 0,?)";
-        int ret = dbStore_->Delete(deleteRows, Events::TABLE, whereClause, whereArgs);
-        if (ret != NativeRdb::E_OK) {
+        if (int ret = DeleteHistoryEvents(dbStore_, reservedNum, reservedNumOs); ret != NativeRdb::E_OK) {
             return ret;
         }
-        HILOG_INFO(LOG_CORE, "delete %{public}d events over limit", deleteRows);
-        return DB_SUCC;
+        // the history events are deleted when the files exceed the quota, so the -wal file is shrunk as well
+        CheckpointWal(true);
+        writeNumSinceCheckpoint_ = 0;
+        return NativeRdb::E_OK;
     };
-    return ExecuteDbOperation(func);
+    return ExecuteWriteOperation(func);
 }
 
 bool AppEventStore::DeleteData(int64_t observerSeq, const std::vector<int64_t>& eventSeqs)
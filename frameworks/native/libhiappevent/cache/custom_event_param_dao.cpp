@@ -129,14 +129,20 @@ int QueryParamkeys(std::shared_ptr<NativeRdb::RdbStore> dbStore, std::unordered_
     return ret == NativeRdb::E_SQLITE_CORRUPT ? ret : NativeRdb::E_OK;
 }
 
-int Query(std::shared_ptr<NativeRdb::RdbStore> dbStore, std::unordered_map<std::string, std::string>& params,
+int Query(std::shared_ptr<NativeRdb::RdbStore> dbStore, std::vector<std::pair<std::string, std::string>>& params,
+    const CustomEvent& customEvent)
+{
+    return Query(*dbStore, params, customEvent);
+}
+
+int Query(NativeRdb::RdbStore& dbStore, std::vector<std::pair<std::string, std::string>>& params,
     const CustomEvent& customEvent)
 {
     NativeRdb::AbsRdbPredicates predicates(TABLE);
     predicates.EqualTo(FIELD_RUNNING_ID, customEvent.runningId);
     predicates.EqualTo(FIELD_DOMAIN, customEvent.domain);
     predicates.EqualTo(FIELD_NAME, customEvent.name);
-    auto resultSet = dbStore->Query(predicates, {FIELD_PARAM_KEY, FIELD_PARAM_VALUE});
+    auto resultSet = dbStore.Query(predicates, {FIELD_PARAM_KEY, FIELD_PARAM_VALUE});
     if (resultSet == nullptr) {
         HILOG_ERROR(LOG_CORE, "failed to query table");
         return NativeRdb::E_ERROR;
@@ -152,7 +158,7 @@ int Query(std::shared_ptr<NativeRdb::RdbStore> dbStore, std::unordered_map<std::
             ret = resultSet->GoToNextRow();
             continue;
         }
-        params[paramKey] = paramValue;
+        params.emplace_back(paramKey, paramValue);
         ret = resultSet->GoToNextRow();
     }
     resultSet->Close();
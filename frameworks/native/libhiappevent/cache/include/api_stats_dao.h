@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 
+#include "app_event_cache_common.h"
 #include "rdb_store.h"
 
 namespace OHOS {
@@ -27,11 +28,15 @@ namespace HiviewDFX {
 namespace ApiStatsDao {
 
 int Create(NativeRdb::RdbStore& dbStore);
-int MetricInsert(std::shared_ptr<NativeRdb::RdbStore> dbStore, const std::string& kitName, const std::string& apiName,
-    const std::string& metric);
-int MetricQueryAll(std::shared_ptr<NativeRdb::RdbStore> dbStore,
-    std::map<std::pair<std::string, std::string>, std::vector<std::string>>& out);
-int MetricClear(std::shared_ptr<NativeRdb::RdbStore> dbStore);
+int BatchInsert(std::shared_ptr<NativeRdb::RdbStore> dbStore,
+    const std::vector<AppEventCacheCommon::ApiStatsRecord>& records);
+int BatchInsert(NativeRdb::RdbStore& dbStore, const std::vector<AppEventCacheCommon::ApiStatsRecord>& records);
+// the records of each api are aggregated by the db, so only one record of each api is read
+int QueryAggregated(std::shared_ptr<NativeRdb::RdbStore> dbStore,
+    std::vector<AppEventCacheCommon::ApiStatsRecord>& records);
+// each row of version 6 keeps a single call as json in the metric column, it is parsed to a typed record
+int QueryMetrics(NativeRdb::RdbStore& dbStore, std::vector<AppEventCacheCommon::ApiStatsRecord>& records);
+int Clear(std::shared_ptr<NativeRdb::RdbStore> dbStore);
 } // namespace ApiStatsDao
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -25,6 +25,13 @@ namespace AppEventCacheCommon {
 constexpr int DB_SUCC = 0;
 constexpr int DB_FAILED = -1;
 
+enum class EventStorageMode {
+    // one record in event_observer_mapping for each event and each observer matched
+    MAPPING = 0,
+    // each observer keeps the seq of the last consumed event, the events after it are pending
+    CURSOR = 1,
+};
+
 namespace Events {
 constexpr const char* TABLE = "events";
 constexpr const char* FIELD_SEQ = "seq";
@@ -50,6 +57,7 @@ constexpr const char* FIELD_SEQ = "seq";
 constexpr const char* FIELD_NAME = "name";
 constexpr const char* FIELD_HASH = "hash";
 constexpr const char* FIELD_FILTERS = "filters";
+constexpr const char* FIELD_CURSOR = "cursor";
 } // namespace Observers
 
 struct Observer {
@@ -62,6 +70,7 @@ struct Observer {
     std::string name;
     int64_t hashCode = 0;
     std::string filters;
+    int64_t cursor = 0;
 };
 
 namespace AppEventMapping {
@@ -116,8 +125,25 @@ const std::string TABLE = "api_stats";
 const std::string FIELD_SEQ = "seq";
 const std::string FIELD_KITNAME = "kit_name";
 const std::string FIELD_APINAME = "api_name";
-const std::string FIELD_METRIC = "metric";
+const std::string FIELD_CALL_TIMES = "call_times";
+const std::string FIELD_SUCCESS_TIMES = "success_times";
+const std::string FIELD_MAX_COST_TIME = "max_cost_time";
+const std::string FIELD_MIN_COST_TIME = "min_cost_time";
+const std::string FIELD_TOTAL_COST_TIME = "total_cost_time";
+const std::string FIELD_ERROR_CODES = "error_codes";
 } // namespace ApiStats
+
+struct ApiStatsRecord {
+    std::string kitName;
+    std::string apiName;
+    int64_t callTimes = 0;
+    int64_t successTimes = 0;
+    int64_t maxCostTime = 0;
+    int64_t minCostTime = 0;
+    int64_t totalCostTime = 0;
+    // the number of the calls of each error code, the records of an api are merged by concatenating them with ','
+    std::string errorCodes;
+};
 } // namespace AppEventCacheCommon
 } // namespace HiviewDFX
 } // namespace OHOS
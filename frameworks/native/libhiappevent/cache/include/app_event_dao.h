@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "rdb_store.h"
 
@@ -25,9 +26,15 @@ namespace HiviewDFX {
 class AppEventPack;
 namespace AppEventDao {
 int Create(NativeRdb::RdbStore& dbStore);
-int Insert(std::shared_ptr<NativeRdb::RdbStore> dbStore, std::shared_ptr<AppEventPack> event, int64_t& seq);
+// the size is the serialized size of the event stored in the size column
+int Insert(std::shared_ptr<NativeRdb::RdbStore> dbStore, std::shared_ptr<AppEventPack> event, int64_t size,
+    int64_t& seq);
+int BatchInsert(std::shared_ptr<NativeRdb::RdbStore> dbStore, const std::vector<std::shared_ptr<AppEventPack>>& events,
+    const std::vector<int64_t>& sizes, std::vector<int64_t>& seqs);
 int Delete(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t eventSeq);
 int Delete(std::shared_ptr<NativeRdb::RdbStore> dbStore, const std::vector<int64_t>& eventSeqs);
+int DeleteBefore(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t maxEventSeq);
+int QueryMaxSeq(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t& seq);
 } // namespace AppEventDao
 } // namespace HiviewDFX
 } // namespace OHOS
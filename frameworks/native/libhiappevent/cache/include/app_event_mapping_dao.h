@@ -28,6 +28,8 @@ namespace AppEventMappingDao {
 int Create(NativeRdb::RdbStore& dbStore);
 int Insert(std::shared_ptr<NativeRdb::RdbStore> dbStore,
     const std::vector<AppEventCacheCommon::EventObserverInfo>& eventObservers);
+int BatchInsert(std::shared_ptr<NativeRdb::RdbStore> dbStore,
+    const std::vector<AppEventCacheCommon::EventObserverInfo>& eventObservers);
 int Delete(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t observerSeq, const std::vector<int64_t>& eventSeqs);
 int QueryExistEvent(std::shared_ptr<NativeRdb::RdbStore> dbStore, const std::vector<int64_t>& eventSeqs,
     std::unordered_set<int64_t>& existEventSeqs);
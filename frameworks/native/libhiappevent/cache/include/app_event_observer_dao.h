@@ -28,6 +28,9 @@ namespace AppEventObserverDao {
 int Create(NativeRdb::RdbStore& dbStore);
 int Insert(std::shared_ptr<NativeRdb::RdbStore> dbStore, const AppEventCacheCommon::Observer& observer, int64_t& seq);
 int Update(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t seq, const std::string& filters);
+int UpdateCursor(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t seq, int64_t cursor);
+int QueryCursor(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t seq, int64_t& cursor);
+int QueryMinCursor(std::shared_ptr<NativeRdb::RdbStore> dbStore, int64_t& cursor, bool& isExist);
 int QuerySeqAndFilters(std::shared_ptr<NativeRdb::RdbStore> dbStore, const AppEventCacheCommon::Observer& observer,
     int64_t& seq, std::string& filters);
 int QuerySeqs(std::shared_ptr<NativeRdb::RdbStore> dbStore, const std::string& name,
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_CACHE_APP_EVENT_STATEMENT_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_CACHE_APP_EVENT_STATEMENT_H
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abs_shared_result_set.h"
+#include "value_object.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+class AppEventPack;
+/*
+ * The sql of each hot statement is built only once and its values are bound by position, so the compiled
+ * statement cached by the rdb connection for the same sql is reused instead of parsing a new sql each time.
+ */
+namespace AppEventStatement {
+// binds: domain, name, type, time, tz, pid, tid, trace_id, span_id, pspan_id, trace_flag, params, running_id, size
+const std::string& InsertEvent();
+
+// binds: observer seq, the max number of the events, -1 means no limit
+const std::string& QueryEventsOfObserver();
+
+// binds: the seq of the event after which the events are queried
+const std::string& QueryEventsAfterSeq();
+
+// binds: observer seq, the result is the number and the total size of the events of the observer
+const std::string& QueryPendingEventsOfObserver();
+
+// the size is bound to the size column, which is the serialized size of the event with its custom params
+void GetEventBindArgs(std::shared_ptr<AppEventPack> event, int64_t size, std::vector<NativeRdb::ValueObject>& bindArgs);
+
+// reads the events from the rows of the events table, the column indexes are resolved once for the result set
+class EventRowReader {
+public:
+    explicit EventRowReader(std::shared_ptr<NativeRdb::AbsSharedResultSet> resultSet);
+    ~EventRowReader() = default;
+
+    // reads the event from the current row of the result set
+    std::shared_ptr<AppEventPack> Read();
+
+    // reads the size of the serialized event stored in the current row of the result set
+    int64_t ReadSize();
+
+private:
+    void CheckColumnIndexes();
+    void ResolveColumnIndexes();
+    int64_t GetLong(size_t column) const;
+    std::string GetString(size_t column) const;
+
+private:
+    static constexpr size_t COLUMN_NUM = 15;
+    std::shared_ptr<NativeRdb::AbsSharedResultSet> resultSet_;
+    std::array<int, COLUMN_NUM> columnIndexes_ {};
+    bool isResolved_ = false;
+};
+} // namespace AppEventStatement
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_CACHE_APP_EVENT_STATEMENT_H
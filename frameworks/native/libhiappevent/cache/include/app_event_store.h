@@ -15,9 +15,16 @@
 #ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_CACHE_APP_EVENT_STORE_H
 #define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_CACHE_APP_EVENT_STORE_H
 
+#include <atomic>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <shared_mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "app_event_dao.h"
@@ -35,24 +42,60 @@ namespace OHOS {
 namespace HiviewDFX {
 class AppEventPack;
 
+struct CustomParamsCache {
+    /* The keys of the cached params in the order of insertion, the oldest one is evicted first when full */
+    std::deque<std::string> keys;
+
+    /* The custom params of each (running_id, domain, name), in the order of the db records */
+    std::unordered_map<std::string, std::vector<std::pair<std::string, std::string>>> params;
+};
+
+struct EventQueryLimit {
+    /* The max number of the events, 0 means no limit */
+    uint32_t row = 0;
+
+    /* The max total size of the serialized events, 0 means no limit */
+    size_t size = 0;
+};
+
 class AppEventStore : public NoCopyable {
 public:
+    using EventFilter = std::function<bool(std::shared_ptr<AppEventPack>)>;
+
     static AppEventStore& GetInstance();
 
+    /*
+     * In EventStorageMode::CURSOR, the pending events of an observer are the events after its cursor which are
+     * matched by its filter, they are queried in ascending order of seq, and deleting the events of an observer
+     * moves its cursor forward over the consumed prefix of its pending events, the events acked out of order are
+     * kept until the events before them are acked. The events behind the min cursor of all the observers are
+     * reclaimed, and at most the latest 10000 events are kept after the min cursor.
+     */
+    void SetStorageMode(AppEventCacheCommon::EventStorageMode mode);
+    AppEventCacheCommon::EventStorageMode GetStorageMode() const;
+    // the filter is used to match the pending events of the observer in EventStorageMode::CURSOR
+    void SetEventFilter(int64_t observerSeq, EventFilter filter);
+
     int InitDbStore();
     int DestroyDbStore();
     int64_t InsertEvent(std::shared_ptr<AppEventPack> event);
+    int InsertEvents(std::vector<std::shared_ptr<AppEventPack>>& events,
+        const std::vector<std::vector<int64_t>>& observerSeqs = {});
     int64_t InsertObserver(const AppEventCacheCommon::Observer& observer);
     int InsertEventMapping(const std::vector<AppEventCacheCommon::EventObserverInfo>& eventObservers);
     int InsertUserId(const std::string& name, const std::string& value);
     int InsertUserProperty(const std::string& name, const std::string& value);
-    int InsertApiMetricInfo(const std::string& kitName, const std::string& apiName, const std::string& metricJson);
+    int InsertApiStats(const std::vector<AppEventCacheCommon::ApiStatsRecord>& records);
     int InsertCustomEventParams(std::shared_ptr<AppEventPack> event);
     int UpdateUserId(const std::string& name, const std::string& value);
     int UpdateUserProperty(const std::string& name, const std::string& value);
     int UpdateObserver(int64_t seq, const std::string& filters);
     int TakeEvents(std::vector<std::shared_ptr<AppEventPack>>& events, int64_t observerSeq, uint32_t eventSize = 0);
     int QueryEvents(std::vector<std::shared_ptr<AppEventPack>>& events, int64_t observerSeq, uint32_t eventSize = 0);
+    // the events are read one by one until their total size exceeds the maxSize
+    int QueryEventsBySize(std::vector<std::shared_ptr<AppEventPack>>& events, int64_t observerSeq, size_t maxSize);
+    // queries the number and the total size of the events of the observer without serializing the events
+    int QueryPendingEvents(int64_t observerSeq, int64_t& row, int64_t& size);
     int64_t QueryObserverSeq(const std::string& name, int64_t hashCode = 0);
     int64_t QueryObserverSeqAndFilters(const std::string& name, int64_t hashCode, std::string& filters);
     int QueryObserverSeqs(const std::string& name, std::vector<int64_t>& observerSeqs);
@@ -61,13 +104,16 @@ public:
     int QueryUserId(const std::string& name, std::string& out);
     int QueryUserProperties(std::unordered_map<std::string, std::string>& out);
     int QueryUserProperty(const std::string& name, std::string& out);
-    int QueryApiMetricInfoAll(std::map<std::pair<std::string, std::string>, std::vector<std::string>>& out);
+    // the records of each api are aggregated into one record
+    int QueryApiStats(std::vector<AppEventCacheCommon::ApiStatsRecord>& records);
+    // queries the aggregated records and deletes all the records at once
+    int TakeApiStats(std::vector<AppEventCacheCommon::ApiStatsRecord>& records);
     int QueryCustomParamsAdd2EventPack(std::shared_ptr<AppEventPack> event);
     int DeleteObserver(int64_t observerSeq);
     int DeleteEventMapping(int64_t observerSeq = 0, const std::vector<int64_t>& eventSeqs = {});
     int DeleteUserId(const std::string& name = "");
     int DeleteUserProperty(const std::string& name = "");
-    int ClearApiMetricInfo();
+    int ClearApiStats();
     int DeleteEvent(int64_t eventSeq = 0);
     int DeleteCustomEventParams();
     int DeleteEvent(const std::vector<int64_t>& eventSeqs);
@@ -81,14 +127,50 @@ private:
     ~AppEventStore();
     bool InitDbStoreDir();
     void CheckAndRepairDbStore(int errCode);
-    int ExecuteDbOperation(const std::function<int()>& func);
-    int ExecuteReadOperation(const std::function<int()>& func, bool& isExecuted);
-    int ExecuteWriteOperation(const std::function<int()>& func, const bool& isExecuted, int& OperationRes);
+    // the queries run on the read connections concurrently, while the mutations are serialized by one writer
+    int ExecuteReadOperation(const std::function<int()>& func);
+    int ExecuteWriteOperation(const std::function<int()>& func);
+    int ExecuteDbOperation(const std::function<int()>& func, bool isWrite);
+    int ExecuteByWriter(const std::function<int()>& func);
+    // commits the transaction, and rolls it back if the commit fails so that the next one can begin
+    int CommitTransaction();
+    void CheckpointWal(bool isTruncate = false);
+    void QueryCustomParams(std::shared_ptr<AppEventPack> event, std::unordered_map<std::string, std::string>& params);
+    int64_t GetStoredEventSize(std::shared_ptr<AppEventPack> event);
+    void ClearCustomParamsCache();
+    bool IsCursorMode() const;
+    EventFilter GetEventFilter(int64_t observerSeq);
+    // the filter of the pending events, which excludes the events acked but still after the cursor
+    EventFilter GetPendingEventFilter(int64_t observerSeq);
+    std::set<int64_t> GetAckedSeqs(int64_t observerSeq);
+    int QueryEventsWithLimit(std::vector<std::shared_ptr<AppEventPack>>& events, int64_t observerSeq,
+        const EventQueryLimit& limit);
+    int QueryEventsAfterCursor(std::vector<std::shared_ptr<AppEventPack>>& events, int64_t observerSeq,
+        const EventQueryLimit& limit);
+    int QueryPendingEventsAfterCursor(int64_t observerSeq, int64_t& row, int64_t& size);
+    int ReadEvents(std::shared_ptr<NativeRdb::AbsSharedResultSet> resultSet, const EventFilter& filter,
+        const EventQueryLimit& limit, std::vector<std::shared_ptr<AppEventPack>>& events);
+    int MoveCursor(int64_t observerSeq, const std::vector<int64_t>& eventSeqs);
+    int QueryConsumedCursor(int64_t observerSeq, int64_t cursor, const EventFilter& filter, int64_t& newCursor);
+    int DeleteEventsBehindCursor(const std::vector<int64_t>& eventSeqs);
 
 private:
     std::shared_ptr<NativeRdb::RdbStore> dbStore_;
     std::string dirPath_;
+    // guards the dbStore_ itself, held exclusively only to open, repair or destroy the db
     std::shared_mutex dbMutex_;
+    std::mutex writerMutex_;
+    uint32_t writeNumSinceCheckpoint_ = 0;
+
+    // replaced as a whole by copy-on-write, so the readers need no lock
+    std::shared_ptr<const CustomParamsCache> customParamsCache_;
+
+    std::atomic<AppEventCacheCommon::EventStorageMode> storageMode_;
+    // guards the filters and the acked seqs of the observers
+    std::mutex filtersMutex_;
+    std::unordered_map<int64_t, EventFilter> eventFilters_;
+    /* <observer seq, seqs of the events acked out of order>, which are after the cursor of the observer */
+    std::unordered_map<int64_t, std::set<int64_t>> ackedSeqs_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -18,6 +18,8 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "app_event_cache_common.h"
 #include "rdb_store.h"
@@ -29,7 +31,9 @@ int Create(NativeRdb::RdbStore& dbStore);
 int BatchInsert(std::shared_ptr<NativeRdb::RdbStore> dbStore, const AppEventCacheCommon::CustomEvent& customEvent);
 int Updates(std::shared_ptr<NativeRdb::RdbStore> dbStore, const AppEventCacheCommon::CustomEvent& customEvent);
 int Delete(std::shared_ptr<NativeRdb::RdbStore> dbStore);
-int Query(std::shared_ptr<NativeRdb::RdbStore> dbStore, std::unordered_map<std::string, std::string>& params,
+int Query(std::shared_ptr<NativeRdb::RdbStore> dbStore, std::vector<std::pair<std::string, std::string>>& params,
+    const AppEventCacheCommon::CustomEvent& customEvent);
+int Query(NativeRdb::RdbStore& dbStore, std::vector<std::pair<std::string, std::string>>& params,
     const AppEventCacheCommon::CustomEvent& customEvent);
 int QueryParamkeys(std::shared_ptr<NativeRdb::RdbStore> dbStore, std::unordered_set<std::string>& out,
     const AppEventCacheCommon::CustomEvent& customEvent);
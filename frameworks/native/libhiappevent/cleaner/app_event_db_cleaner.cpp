@@ -29,6 +29,8 @@ namespace OHOS {
 namespace HiviewDFX {
 namespace {
 constexpr const char* DATABASE_NAME = "databases/appevent.db";
+constexpr const char* DATABASE_WAL_SUFFIX = "-wal";
+constexpr const char* DATABASE_SHM_SUFFIX = "-shm";
 constexpr int RESERVED_NUM = 1000;
 constexpr int RESERVED_NUM_OS = 150;
 
@@ -69,7 +71,10 @@ void ClearHistoryData()
 }
 uint64_t AppEventDbCleaner::GetFilesSize()
 {
-    return FileUtil::GetFileSize(path_ + DATABASE_NAME);
+    // the write-ahead log and its index take the storage space as well until they are checkpointed
+    std::string dbPath = path_ + DATABASE_NAME;
+    return FileUtil::GetFileSize(dbPath) + FileUtil::GetFileSize(dbPath + DATABASE_WAL_SUFFIX)
+        + FileUtil::GetFileSize(dbPath + DATABASE_SHM_SUFFIX);
 }
 
 uint64_t AppEventDbCleaner::ClearSpace(uint64_t curSize, uint64_t maxSize)
@@ -15,11 +15,18 @@
 
 #include "hiappevent_base.h"
 
+#include <charconv>
+#include <cstdio>
 #include <ctime>
-#include <iomanip>
-#include <sstream>
+#include <iterator>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unistd.h>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "hiappevent_config.h"
@@ -39,139 +46,201 @@ namespace {
 constexpr const char* DEFAULT_DOMAIN = "default";
 constexpr size_t MIN_PARAM_STR_LEN = 3; // 3: '{}\0'
 
-std::string TrimRightZero(const std::string& str)
+constexpr size_t INTEGER_BUF_SIZE = 24; // enough for the decimal digits and sign of int64_t
+constexpr size_t FLOATING_BUF_SIZE = 512; // enough for the fixed notation of DBL_MAX
+constexpr size_t EVENT_STR_RESERVED_SIZE = 1024;
+constexpr size_t EVENT_STR_BUF_MAX_SIZE = 64 * 1024; // the buffer larger than 64K is released after use
+
+template<typename T>
+void AppendInteger(std::string& out, T value)
 {
-    auto endIndex = str.find_last_not_of("0");
-    if (endIndex == std::string::npos) {
-        return str;
+    char buf[INTEGER_BUF_SIZE] = {0};
+    auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+    if (ec == std::errc()) {
+        out.append(buf, ptr - buf);
     }
-
-    return (str[endIndex] == '.') ? str.substr(0, endIndex) : str.substr(0, endIndex + 1);
 }
 
-template<typename T>
-std::string GetValueStr(const T& value)
+void AppendFloating(std::string& out, double value)
 {
-    return std::to_string(value);
+    // keep the format of std::to_string, and then trim the zeros on the right
+    char buf[FLOATING_BUF_SIZE] = {0};
+    int len = snprintf(buf, sizeof(buf), "%f", value);
+    if (len <= 0 || static_cast<size_t>(len) >= sizeof(buf)) {
+        return;
+    }
+    std::string_view str(buf, static_cast<size_t>(len));
+    auto endIndex = str.find_last_not_of('0');
+    if (endIndex != std::string_view::npos) {
+        str = str.substr(0, (str[endIndex] == '.') ? endIndex : (endIndex + 1));
+    }
+    out.append(str);
 }
 
-std::string GetValueStr(bool value)
+void AppendQuotedStr(std::string& out, const std::string& str)
 {
-    return value ? "true" : "false";
+    out.push_back('"');
+    out.append(str);
+    out.push_back('"');
 }
 
-std::string GetValueStr(char value)
+template<typename T>
+void AppendValue(std::string& out, const T& value)
 {
-    return "\"" + std::to_string(value) + "\"";
+    if constexpr (std::is_same_v<T, std::monostate>) {
+        return;
+    } else if constexpr (std::is_same_v<T, bool>) {
+        out.append(value ? "true" : "false");
+    } else if constexpr (std::is_same_v<T, char>) {
+        out.push_back('"');
+        AppendInteger(out, static_cast<int>(value));
+        out.push_back('"');
+    } else if constexpr (std::is_floating_point_v<T>) {
+        AppendFloating(out, static_cast<double>(value));
+    } else if constexpr (std::is_integral_v<T>) {
+        AppendInteger(out, value);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        AppendQuotedStr(out, value);
+    } else {
+        out.push_back('[');
+        size_t valuesSize = value.size();
+        for (size_t i = 0; i < valuesSize; ++i) {
+            if (i != 0) {
+                out.push_back(',');
+            }
+            typename T::const_reference item = value[i]; // vector<bool> is stored as bit type
+            AppendValue(out, item);
+        }
+        out.push_back(']');
+    }
 }
 
-std::string GetValueStr(float value)
+void AppendParamValue(std::string& out, const AppEventParamValue& value)
 {
-    return TrimRightZero(std::to_string(value));
+    std::visit([&out](const auto& realValue) {
+        AppendValue(out, realValue);
+    }, value);
 }
 
-std::string GetValueStr(double value)
+std::string GetParamValueStr(const AppEventParam& param)
 {
-    return TrimRightZero(std::to_string(value));
+    std::string valueStr;
+    AppendParamValue(valueStr, param.value);
+    return valueStr;
 }
 
-std::string GetValueStr(const std::string& value)
+std::string& GetEventStrBuffer()
 {
-    return "\"" + value + "\"";
+    thread_local std::string buffer;
+    if (buffer.capacity() > EVENT_STR_BUF_MAX_SIZE) {
+        std::string().swap(buffer);
+    }
+    buffer.clear();
+    buffer.reserve(EVENT_STR_RESERVED_SIZE);
+    return buffer;
 }
 
-template<typename T>
-std::string GetValuesStr(const std::vector<T>& values)
-{
-    std::string valuesStr;
-    valuesStr.append("[");
-    size_t valuesSize = values.size();
-    for (size_t i = 0; i < valuesSize; ++i) {
-        if constexpr (std::is_same_v<std::decay_t<T>, bool>) { // vector<bool> is stored as bit type
-            bool bValue = values[i];
-            valuesStr.append(GetValueStr(bValue));
-        } else {
-            valuesStr.append(GetValueStr(values[i]));
+constexpr size_t MAX_SYMBOL_NUM = 4096;
+
+struct SymbolEntry {
+    /* The id of the interned string, which is the order of interning */
+    uint32_t id = AppEventSymbol::INVALID_ID;
+
+    /* The interned string, shared by all the symbols of the same string */
+    std::shared_ptr<const std::string> str;
+};
+
+class SymbolTable {
+public:
+    static SymbolTable& GetInstance()
+    {
+        static SymbolTable instance;
+        return instance;
+    }
+
+    bool Find(const std::string& str, SymbolEntry& entry)
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        if (auto it = entries_.find(str); it != entries_.end()) {
+            entry = it->second;
+            return true;
         }
-        if (i != (valuesSize - 1)) { // -1 for last value
-            valuesStr.append(",");
+        return false;
+    }
+
+    bool Intern(const std::string& str, bool isForced, SymbolEntry& entry)
+    {
+        if (Find(str, entry)) {
+            return true;
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        if (auto it = entries_.find(str); it != entries_.end()) {
+            entry = it->second;
+            return true;
         }
+        if (entries_.size() >= MAX_SYMBOL_NUM && !isForced) {
+            return false;
+        }
+        entry.id = static_cast<uint32_t>(entries_.size());
+        entry.str = std::make_shared<const std::string>(str);
+        // the key refers to the interned string, which is never released
+        entries_.emplace(*entry.str, entry);
+        return true;
     }
-    valuesStr.append("]");
-    return valuesStr;
+
+private:
+    std::shared_mutex mutex_;
+    std::unordered_map<std::string_view, SymbolEntry> entries_;
+};
 }
 
-template<typename T>
-std::string GetParamValueStrByType(const AppEventParamValue& value)
+AppEventSymbol::AppEventSymbol()
 {
-    auto* ptr = std::get_if<T>(&value);
-    if (ptr == nullptr) {
-        HILOG_WARN(LOG_CORE, "the variant value type mismatch.");
-        return "";
-    }
-    return GetValueStr(*ptr);
+    static const AppEventSymbol emptySymbol("", true);
+    *this = emptySymbol;
 }
 
-template<typename T>
-std::string GetParamValuesStrByType(const AppEventParamValue& value)
+AppEventSymbol::AppEventSymbol(const std::string& str, bool isForced)
 {
-    auto* ptr = std::get_if<T>(&value);
-    if (ptr == nullptr) {
-        HILOG_WARN(LOG_CORE, "the variant values type mismatch for vector type.");
-        return "";
+    SymbolEntry entry;
+    if (SymbolTable::GetInstance().Intern(str, isForced, entry)) {
+        id_ = entry.id;
+        str_ = std::move(entry.str);
+        return;
     }
-    return GetValuesStr(*ptr);
+    str_ = std::make_shared<const std::string>(str);
 }
 
-std::string GetParamValueStr(const AppEventParam& param)
+uint32_t AppEventSymbol::GetId() const
 {
-    switch (param.value.index()) {
-        case AppEventParamType::EMPTY:
-            return "";
-        case AppEventParamType::BOOL:
-            return GetParamValueStrByType<bool>(param.value);
-        case AppEventParamType::CHAR:
-            return GetParamValueStrByType<char>(param.value);
-        case AppEventParamType::SHORT:
-            return GetParamValueStrByType<int16_t>(param.value);
-        case AppEventParamType::INTEGER:
-            return GetParamValueStrByType<int>(param.value);
-        case AppEventParamType::LONGLONG:
-            return GetParamValueStrByType<int64_t>(param.value);
-        case AppEventParamType::FLOAT:
-            return GetParamValueStrByType<float>(param.value);
-        case AppEventParamType::DOUBLE:
-            return GetParamValueStrByType<double>(param.value);
-        case AppEventParamType::STRING:
-            return GetParamValueStrByType<std::string>(param.value);
-        case AppEventParamType::BVECTOR:
-            return GetParamValuesStrByType<std::vector<bool>>(param.value);
-        case AppEventParamType::CVECTOR:
-            return GetParamValuesStrByType<std::vector<char>>(param.value);
-        case AppEventParamType::SHVECTOR:
-            return GetParamValuesStrByType<std::vector<int16_t>>(param.value);
-        case AppEventParamType::IVECTOR:
-            return GetParamValuesStrByType<std::vector<int>>(param.value);
-        case AppEventParamType::LLVECTOR:
-            return GetParamValuesStrByType<std::vector<int64_t>>(param.value);
-        case AppEventParamType::FVECTOR:
-            return GetParamValuesStrByType<std::vector<float>>(param.value);
-        case AppEventParamType::DVECTOR:
-            return GetParamValuesStrByType<std::vector<double>>(param.value);
-        case AppEventParamType::STRVECTOR:
-            return GetParamValuesStrByType<std::vector<std::string>>(param.value);
-        default:
-            return "";
-    }
+    return id_;
 }
+
+const std::string& AppEventSymbol::GetStr() const
+{
+    return *str_;
+}
+
+uint32_t AppEventSymbol::FindId(const std::string& str)
+{
+    SymbolEntry entry;
+    return SymbolTable::GetInstance().Find(str, entry) ? entry.id : INVALID_ID;
 }
 
-AppEventParam::AppEventParam(std::string n, AppEventParamValue v) : name(n), value(v)
+AppEventParam::AppEventParam(std::string n, AppEventParamValue v) : name(std::move(n)), value(std::move(v))
 {}
 
 AppEventParam::AppEventParam(const AppEventParam& param) : name(param.name), value(param.value)
 {}
 
+AppEventParam::AppEventParam(AppEventParam&& param) noexcept
+    : name(std::move(param.name)), value(std::move(param.value))
+{}
+
+AppEventParam& AppEventParam::operator=(const AppEventParam& param) = default;
+
+AppEventParam& AppEventParam::operator=(AppEventParam&& param) noexcept = default;
+
 AppEventParam::~AppEventParam()
 {}
 
@@ -223,47 +292,56 @@ void AppEventPack::InitRunningId()
 
 void AppEventPack::AddParam(const std::string& key)
 {
-    baseParams_.emplace_back(AppEventParam(key, std::monostate{}));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, std::monostate{});
 }
 
 void AppEventPack::AddParam(const std::string& key, bool b)
 {
-    baseParams_.emplace_back(AppEventParam(key, b));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, b);
 }
 
 void AppEventPack::AddParam(const std::string& key, char c)
 {
-    baseParams_.emplace_back(AppEventParam(key, c));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, c);
 }
 
 void AppEventPack::AddParam(const std::string& key, int8_t num)
 {
-    baseParams_.emplace_back(AppEventParam(key, static_cast<int16_t>(num)));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, static_cast<int16_t>(num));
 }
 
 void AppEventPack::AddParam(const std::string& key, int16_t s)
 {
-    baseParams_.emplace_back(AppEventParam(key, s));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, s);
 }
 
 void AppEventPack::AddParam(const std::string& key, int i)
 {
-    baseParams_.emplace_back(AppEventParam(key, i));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, i);
 }
 
 void AppEventPack::AddParam(const std::string& key, int64_t ll)
 {
-    baseParams_.emplace_back(AppEventParam(key, ll));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, ll);
 }
 
 void AppEventPack::AddParam(const std::string& key, float f)
 {
-    baseParams_.emplace_back(AppEventParam(key, f));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, f);
 }
 
 void AppEventPack::AddParam(const std::string& key, double d)
 {
-    baseParams_.emplace_back(AppEventParam(key, d));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, d);
 }
 
 void AppEventPack::AddParam(const std::string& key, const char *s)
@@ -271,53 +349,63 @@ void AppEventPack::AddParam(const std::string& key, const char *s)
     if (s == nullptr) {
         return;
     }
-    baseParams_.emplace_back(AppEventParam(key, s));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, s);
 }
 
 void AppEventPack::AddParam(const std::string& key, const std::string& s)
 {
-    baseParams_.emplace_back(AppEventParam(key, s));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, s);
 }
 
 void AppEventPack::AddParam(const std::string& key, const std::vector<bool>& bs)
 {
-    baseParams_.emplace_back(AppEventParam(key, bs));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, bs);
 }
 
 void AppEventPack::AddParam(const std::string& key, const std::vector<char>& cs)
 {
-    baseParams_.emplace_back(AppEventParam(key, cs));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, cs);
 }
 
 void AppEventPack::AddParam(const std::string& key, const std::vector<int8_t>& shs)
 {
     std::vector<int16_t> values(shs.begin(), shs.end());
-    baseParams_.emplace_back(AppEventParam(key, std::move(values)));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, std::move(values));
 }
 
 void AppEventPack::AddParam(const std::string& key, const std::vector<int16_t>& shs)
 {
-    baseParams_.emplace_back(AppEventParam(key, shs));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, shs);
 }
 
 void AppEventPack::AddParam(const std::string& key, const std::vector<int>& is)
 {
-    baseParams_.emplace_back(AppEventParam(key, is));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, is);
 }
 
 void AppEventPack::AddParam(const std::string& key, const std::vector<int64_t>& lls)
 {
-    baseParams_.emplace_back(AppEventParam(key, lls));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, lls);
 }
 
 void AppEventPack::AddParam(const std::string& key, const std::vector<float>& fs)
 {
-    baseParams_.emplace_back(AppEventParam(key, fs));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, fs);
 }
 
 void AppEventPack::AddParam(const std::string& key, const std::vector<double>& ds)
 {
-    baseParams_.emplace_back(AppEventParam(key, ds));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, ds);
 }
 
 void AppEventPack::AddParam(const std::string& key, const std::vector<const char*>& cps)
@@ -330,12 +418,14 @@ void AppEventPack::AddParam(const std::string& key, const std::vector<const char
             }
         }
     }
-    baseParams_.emplace_back(AppEventParam(key, std::move(strs)));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, std::move(strs));
 }
 
 void AppEventPack::AddParam(const std::string& key, const std::vector<std::string>& strs)
 {
-    baseParams_.emplace_back(AppEventParam(key, strs));
+    InvalidateEventStr();
+    baseParams_.emplace_back(key, strs);
 }
 
 void AppEventPack::AddCustomParams(const std::unordered_map<std::string, std::string>& customParams)
@@ -345,28 +435,52 @@ void AppEventPack::AddCustomParams(const std::unordered_map<std::string, std::st
     }
     std::string paramStr = GetParamStr();
     if (paramStr.size() >= MIN_PARAM_STR_LEN) {
-        std::stringstream jsonStr;
-        if (paramStr.size() > MIN_PARAM_STR_LEN) {
-            jsonStr << ",";
-        }
+        std::string customParamStr;
         for (auto it = customParams.begin(); it != customParams.end(); ++it) {
-            jsonStr << "\"" << it->first << "\":" << it->second << ",";
+            customParamStr.push_back(',');
+            AppendQuotedStr(customParamStr, it->first);
+            customParamStr.push_back(':');
+            customParamStr.append(it->second);
+        }
+        if (paramStr.size() == MIN_PARAM_STR_LEN) {
+            customParamStr.erase(0, 1); // 1 for delete the first ','
         }
-        std::string customParamStr = jsonStr.str();
-        customParamStr.erase(customParamStr.end() - 1); // -1 for delete ','
         paramStr.insert(paramStr.size() - 2, customParamStr); // 2 for '}\0'
         paramStr_ = paramStr;
+        InvalidateEventStr();
     }
 }
 
 std::string AppEventPack::GetEventStr() const
 {
-    std::stringstream jsonStr;
-    jsonStr << "{";
+    return *GetEventStrCache();
+}
+
+size_t AppEventPack::GetEventSize() const
+{
+    return GetEventStrCache()->size();
+}
+
+std::shared_ptr<const std::string> AppEventPack::GetEventStrCache() const
+{
+    // the event may be shared by several threads, so the cache is accessed atomically
+    auto eventStr = std::atomic_load(&eventStrCache_);
+    if (eventStr != nullptr) {
+        return eventStr;
+    }
+    std::string& jsonStr = GetEventStrBuffer();
+    jsonStr.push_back('{');
     AddBaseInfoToJsonString(jsonStr);
     AddParamsInfoToJsonString(jsonStr);
-    jsonStr << "}" << std::endl;
-    return jsonStr.str();
+    jsonStr.append("}\n");
+    eventStr = std::make_shared<const std::string>(jsonStr);
+    std::atomic_store(&eventStrCache_, eventStr);
+    return eventStr;
+}
+
+void AppEventPack::InvalidateEventStr()
+{
+    std::atomic_store(&eventStrCache_, std::shared_ptr<const std::string>());
 }
 
 std::string AppEventPack::GetParamStr() const
@@ -375,41 +489,52 @@ std::string AppEventPack::GetParamStr() const
         return paramStr_;
     }
 
-    std::stringstream jsonStr;
-    jsonStr << "{";
+    std::string& jsonStr = GetEventStrBuffer();
+    jsonStr.push_back('{');
     AddParamsToJsonString(jsonStr);
-    jsonStr << "}" << std::endl;
-    return jsonStr.str();
-}
-
-void AppEventPack::AddBaseInfoToJsonString(std::stringstream& jsonStr) const
-{
-    jsonStr << "\"" << "domain_" << "\":" << "\"" << domain_ << "\",";
-    jsonStr << "\"" << "name_" << "\":" << "\"" << name_ << "\",";
-    jsonStr << "\"" << "type_" << "\":" <<  type_ << ",";
-    jsonStr << "\"" << "time_" << "\":" << std::to_string(time_) << ",";
-    jsonStr << "\"tz_\":\"" << timeZone_ << "\",";
-    jsonStr << "\"" << "pid_" << "\":" << pid_ << ",";
-    jsonStr << "\"" << "tid_" << "\":" << tid_;
+    jsonStr.append("}\n");
+    return jsonStr;
+}
+
+void AppEventPack::AddBaseInfoToJsonString(std::string& jsonStr) const
+{
+    jsonStr.append("\"domain_\":");
+    AppendQuotedStr(jsonStr, domain_.GetStr());
+    jsonStr.append(",\"name_\":");
+    AppendQuotedStr(jsonStr, name_.GetStr());
+    jsonStr.append(",\"type_\":");
+    AppendInteger(jsonStr, type_);
+    jsonStr.append(",\"time_\":");
+    AppendInteger(jsonStr, time_);
+    jsonStr.append(",\"tz_\":");
+    AppendQuotedStr(jsonStr, timeZone_);
+    jsonStr.append(",\"pid_\":");
+    AppendInteger(jsonStr, pid_);
+    jsonStr.append(",\"tid_\":");
+    AppendInteger(jsonStr, tid_);
     AddTraceInfoToJsonString(jsonStr);
 }
 
-void AppEventPack::AddTraceInfoToJsonString(std::stringstream& jsonStr) const
+void AppEventPack::AddTraceInfoToJsonString(std::string& jsonStr) const
 {
     if (traceId_ == 0) {
         return;
     }
-    jsonStr << "," << "\"" << "traceid_" << "\":" << traceId_;
-    jsonStr << "," << "\"" << "spanid_" << "\":" << spanId_;
-    jsonStr << "," << "\"" << "pspanid_" << "\":" << pspanId_;
-    jsonStr << "," << "\"" << "trace_flag_" << "\":" << traceFlag_;
+    jsonStr.append(",\"traceid_\":");
+    AppendInteger(jsonStr, traceId_);
+    jsonStr.append(",\"spanid_\":");
+    AppendInteger(jsonStr, spanId_);
+    jsonStr.append(",\"pspanid_\":");
+    AppendInteger(jsonStr, pspanId_);
+    jsonStr.append(",\"trace_flag_\":");
+    AppendInteger(jsonStr, traceFlag_);
 }
 
-void AppEventPack::AddParamsInfoToJsonString(std::stringstream& jsonStr) const
+void AppEventPack::AddParamsInfoToJsonString(std::string& jsonStr) const
 {
     // for event from writing
     if (baseParams_.size() != 0) {
-        jsonStr << ",";
+        jsonStr.push_back(',');
         AddParamsToJsonString(jsonStr);
         return;
     }
@@ -417,19 +542,23 @@ void AppEventPack::AddParamsInfoToJsonString(std::stringstream& jsonStr) const
     // for event from the db
     size_t paramStrLen = paramStr_.length();
     if (paramStrLen > MIN_PARAM_STR_LEN) {
-        jsonStr << "," << paramStr_.substr(1, paramStrLen - MIN_PARAM_STR_LEN); // 1: '{' for next char
+        jsonStr.push_back(',');
+        jsonStr.append(paramStr_, 1, paramStrLen - MIN_PARAM_STR_LEN); // 1: '{' for next char
     }
 }
 
-void AppEventPack::AddParamsToJsonString(std::stringstream& jsonStr) const
+void AppEventPack::AddParamsToJsonString(std::string& jsonStr) const
 {
-    if (baseParams_.empty()) {
-        return;
-    }
+    bool isFirst = true;
     for (const auto& param : baseParams_) {
-        jsonStr << "\"" << param.name << "\":" << GetParamValueStr(param) << ",";
+        if (!isFirst) {
+            jsonStr.push_back(',');
+        }
+        isFirst = false;
+        AppendQuotedStr(jsonStr, param.name);
+        jsonStr.push_back(':');
+        AppendParamValue(jsonStr, param.value);
     }
-    jsonStr.seekp(-1, std::ios_base::end); // -1 for delete ','
 }
 
 void AppEventPack::GetCustomParams(std::vector<CustomEventParam>& customParams) const
@@ -449,16 +578,36 @@ int64_t AppEventPack::GetSeq() const
     return seq_;
 }
 
-std::string AppEventPack::GetDomain() const
+const std::string& AppEventPack::GetDomain() const
+{
+    return domain_.GetStr();
+}
+
+const std::string& AppEventPack::GetName() const
+{
+    return name_.GetStr();
+}
+
+const AppEventSymbol& AppEventPack::GetDomainSymbol() const
 {
     return domain_;
 }
 
-std::string AppEventPack::GetName() const
+const AppEventSymbol& AppEventPack::GetNameSymbol() const
 {
     return name_;
 }
 
+uint32_t AppEventPack::GetDomainId() const
+{
+    return domain_.GetId();
+}
+
+uint32_t AppEventPack::GetNameId() const
+{
+    return name_.GetId();
+}
+
 int AppEventPack::GetType() const
 {
     return type_;
@@ -509,11 +658,19 @@ std::string AppEventPack::GetRunningId() const
     return runningId_;
 }
 
-std::list<AppEventParam> AppEventPack::GetBaseParams() const
+const AppEventParams& AppEventPack::GetBaseParams() const
 {
     return baseParams_;
 }
 
+AppEventParams AppEventPack::TakeBaseParams()
+{
+    InvalidateEventStr();
+    AppEventParams baseParams = std::move(baseParams_);
+    baseParams_.clear();
+    return baseParams;
+}
+
 void AppEventPack::SetSeq(int64_t seq)
 {
     seq_ = seq;
@@ -521,57 +678,68 @@ void AppEventPack::SetSeq(int64_t seq)
 
 void AppEventPack::SetDomain(const std::string& domain)
 {
-    domain_ = domain;
+    domain_ = AppEventSymbol(domain);
+    InvalidateEventStr();
 }
 
 void AppEventPack::SetName(const std::string& name)
 {
-    name_ = name;
+    name_ = AppEventSymbol(name);
+    InvalidateEventStr();
 }
 
 void AppEventPack::SetType(int type)
 {
     type_ = type;
+    InvalidateEventStr();
 }
 
 void AppEventPack::SetTime(uint64_t time)
 {
     time_ = time;
+    InvalidateEventStr();
 }
 
 void AppEventPack::SetTimeZone(const std::string& timeZone)
 {
     timeZone_ = timeZone;
+    InvalidateEventStr();
 }
 
 void AppEventPack::SetPid(int pid)
 {
     pid_ = pid;
+    InvalidateEventStr();
 }
 
 void AppEventPack::SetTid(int tid)
 {
     tid_ = tid;
+    InvalidateEventStr();
 }
 
 void AppEventPack::SetTraceId(int64_t traceId)
 {
     traceId_ = traceId;
+    InvalidateEventStr();
 }
 
 void AppEventPack::SetSpanId(int64_t spanId)
 {
     spanId_ = spanId;
+    InvalidateEventStr();
 }
 
 void AppEventPack::SetPspanId(int64_t pspanId)
 {
     pspanId_ = pspanId;
+    InvalidateEventStr();
 }
 
 void AppEventPack::SetTraceFlag(int traceFlag)
 {
     traceFlag_ = traceFlag;
+    InvalidateEventStr();
 }
 
 void AppEventPack::SetRunningId(const std::string& runningId)
@@ -579,16 +747,28 @@ void AppEventPack::SetRunningId(const std::string& runningId)
     runningId_ = runningId;
 }
 
-void AppEventPack::SetBaseParams(const std::list<AppEventParam>& baseParams)
+void AppEventPack::SetBaseParams(const AppEventParams& baseParams)
 {
-    for (const auto& baseParam : baseParams) {
-        baseParams_.push_back(baseParam);
+    InvalidateEventStr();
+    baseParams_.insert(baseParams_.end(), baseParams.begin(), baseParams.end());
+}
+
+void AppEventPack::SetBaseParams(AppEventParams&& baseParams)
+{
+    InvalidateEventStr();
+    if (baseParams_.empty()) {
+        baseParams_ = std::move(baseParams);
+        return;
     }
+    baseParams_.insert(baseParams_.end(), std::make_move_iterator(baseParams.begin()),
+        std::make_move_iterator(baseParams.end()));
+    baseParams.clear();
 }
 
 void AppEventPack::SetParamStr(const std::string& paramStr)
 {
     paramStr_ = paramStr;
+    InvalidateEventStr();
 }
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -15,7 +15,9 @@
 
 #include "hiappevent_clean.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "app_event_db_cleaner.h"
@@ -36,9 +38,35 @@ namespace OHOS {
 namespace HiviewDFX {
 namespace HiAppEventClean {
 namespace {
-constexpr int EVENT_COUNT_OF_CHECK_SPACE = 1000;
+constexpr size_t EVENT_COUNT_OF_CHECK_SPACE = 1000;
+constexpr const char* CLEAN_TASK_NAME = "app_event_clean";
 
-static std::atomic<int> g_eventCount = -1;
+struct StorageUsage {
+    /* The storage dir that the usage is accounted for */
+    std::string dir;
+
+    /* Whether the usage is seeded by scanning the storage dir */
+    bool isSeeded = false;
+
+    /* The size of the log files, increased by the size of the written events */
+    uint64_t logSize = 0;
+
+    /* The total size of the written events, used to keep the events written while the storage dir is scanned */
+    uint64_t addedLogSize = 0;
+
+    /* The size of the db file, refreshed every EVENT_COUNT_OF_CHECK_SPACE events */
+    uint64_t dbSize = 0;
+
+    /* The number of the events written since the db size is refreshed */
+    size_t eventCount = 0;
+
+    /* Whether the size exceeded the max storage size at the last check */
+    bool isFull = false;
+};
+
+std::mutex g_usageMutex;
+StorageUsage g_usage;
+std::atomic<bool> g_isCleaning = false;
 
 void CreateCleaners(const std::string& dir, std::vector<std::shared_ptr<AppEventCleaner>>& cleaners)
 {
@@ -56,6 +84,47 @@ uint64_t GetCurStorageSize(const std::string& dir)
     }
     return curSize;
 }
+
+void SeedStorageUsage(const std::string& dir)
+{
+    uint64_t addedLogSize = 0;
+    {
+        std::lock_guard<std::mutex> lock(g_usageMutex);
+        addedLogSize = g_usage.addedLogSize;
+    }
+    // scan the storage dir outside of the lock
+    AppEventLogCleaner logCleaner(dir);
+    AppEventDbCleaner dbCleaner(dir);
+    uint64_t logSize = logCleaner.GetFilesSize();
+    uint64_t dbSize = dbCleaner.GetFilesSize();
+    std::lock_guard<std::mutex> lock(g_usageMutex);
+    g_usage.dir = dir;
+    g_usage.isSeeded = true;
+    // the events written during the scan may be missed by the scan, so add them on top of the scanned size
+    g_usage.logSize = logSize + (g_usage.addedLogSize - addedLogSize);
+    g_usage.dbSize = dbSize;
+    g_usage.eventCount = 0;
+}
+
+void ResetStorageUsage()
+{
+    std::lock_guard<std::mutex> lock(g_usageMutex);
+    g_usage.isSeeded = false;
+    g_usage.isFull = false;
+}
+
+void SubmitCleanTask(const std::string& dir, uint64_t maxSize)
+{
+    if (g_isCleaning.exchange(true)) {
+        return;
+    }
+    HILOG_INFO(LOG_CORE, "hiappevent dir space is full, start to clean");
+    AppEventObserverMgr::GetInstance().SubmitTaskToFFRTQueue([dir, maxSize] {
+        ReleaseSomeStorageSpace(dir, maxSize);
+        SeedStorageUsage(dir);
+        g_isCleaning = false;
+    }, CLEAN_TASK_NAME);
+}
 }
 bool IsStorageSpaceFull(const std::string& dir, uint64_t maxSize)
 {
@@ -91,20 +160,64 @@ void ClearData(const std::string& dir)
     for (auto& cleaner : cleaners) { // clear the db data first
         cleaner->ClearData();
     }
+    ResetStorageUsage();
+}
+
+void AddStorageSize(uint64_t size)
+{
+    std::lock_guard<std::mutex> lock(g_usageMutex);
+    g_usage.logSize += size;
+    g_usage.addedLogSize += size;
 }
 
-void CheckStorageSpace()
+uint64_t GetStorageSize()
 {
-    if (g_eventCount == -1 || g_eventCount >= (EVENT_COUNT_OF_CHECK_SPACE - 1)) {
-        std::string dir = HiAppEventConfig::GetInstance().GetStorageDir();
-        auto maxSize = HiAppEventConfig::GetInstance().GetMaxStorageSize();
-        if (!IsStorageSpaceFull(dir, maxSize)) {
-            return;
+    std::string dir = HiAppEventConfig::GetInstance().GetStorageDir();
+    if (dir.empty()) {
+        return 0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_usageMutex);
+        if (g_usage.isSeeded && g_usage.dir == dir) {
+            return g_usage.logSize + g_usage.dbSize;
         }
-        HILOG_INFO(LOG_CORE, "hiappevent dir space is full, start to clean");
-        ReleaseSomeStorageSpace(dir, maxSize);
     }
-    g_eventCount = (++g_eventCount) % EVENT_COUNT_OF_CHECK_SPACE;
+    SeedStorageUsage(dir);
+    std::lock_guard<std::mutex> lock(g_usageMutex);
+    return g_usage.logSize + g_usage.dbSize;
+}
+
+void CheckStorageSpace(size_t eventNum)
+{
+    std::string dir = HiAppEventConfig::GetInstance().GetStorageDir();
+    if (dir.empty()) {
+        return;
+    }
+    bool isDbSizeExpired = false;
+    {
+        std::lock_guard<std::mutex> lock(g_usageMutex);
+        g_usage.eventCount += eventNum;
+        isDbSizeExpired = g_usage.eventCount >= EVENT_COUNT_OF_CHECK_SPACE;
+    }
+    if (isDbSizeExpired) {
+        // the db file grows by pages, so its size is only refreshed periodically by a stat
+        uint64_t dbSize = AppEventDbCleaner(dir).GetFilesSize();
+        std::lock_guard<std::mutex> lock(g_usageMutex);
+        g_usage.dbSize = dbSize;
+        g_usage.eventCount = 0;
+    }
+    auto maxSize = HiAppEventConfig::GetInstance().GetMaxStorageSize();
+    uint64_t curSize = GetStorageSize();
+    bool wasFull = false;
+    {
+        std::lock_guard<std::mutex> lock(g_usageMutex);
+        wasFull = g_usage.isFull;
+        g_usage.isFull = curSize > maxSize;
+    }
+    // clean when the size crosses the max size, and retry with the refreshed db size if it is still full
+    if (curSize > maxSize && (!wasFull || isDbSizeExpired)) {
+        SubmitCleanTask(dir, maxSize);
+    }
 }
 } // namespace HiAppEventClean
 } // namespace HiviewDFX
@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <cinttypes>
 #include <cstdlib>
+#include <memory>
 #include <mutex>
 #include <regex>
 #include <sstream>
@@ -96,6 +97,23 @@ HiAppEventConfig& HiAppEventConfig::GetInstance()
     return instance;
 }
 
+HiAppEventConfig::HiAppEventConfig() : snapshot_(std::make_shared<const Snapshot>())
+{}
+
+std::shared_ptr<const HiAppEventConfig::Snapshot> HiAppEventConfig::GetSnapshot() const
+{
+    return std::atomic_load(&snapshot_);
+}
+
+// the caller must hold g_mutex, so that the concurrent updates are not lost
+template<typename Func>
+void HiAppEventConfig::UpdateSnapshot(Func&& func)
+{
+    auto snapshot = std::make_shared<Snapshot>(*GetSnapshot());
+    func(*snapshot);
+    std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>(std::move(snapshot)));
+}
+
 bool HiAppEventConfig::SetConfigurationItem(std::string name, std::string value)
 {
     // trans uppercase to underscore and lowercase
@@ -193,37 +211,45 @@ bool HiAppEventConfig::SetMaxStorageSizeItem(const std::string& value)
 void HiAppEventConfig::SetDisable(bool disable)
 {
     std::lock_guard<std::mutex> lockGuard(g_mutex);
-    disable_ = disable;
+    UpdateSnapshot([disable](Snapshot& snapshot) {
+        snapshot.disable = disable;
+    });
 }
 
 void HiAppEventConfig::SetMaxStorageSize(uint64_t size)
 {
     std::lock_guard<std::mutex> lockGuard(g_mutex);
-    maxStorageSize_ = size;
+    UpdateSnapshot([size](Snapshot& snapshot) {
+        snapshot.maxStorageSize = size;
+    });
 }
 
 void HiAppEventConfig::SetStorageDir(const std::string& dir)
 {
-    storageDir_ = dir;
+    std::lock_guard<std::mutex> lockGuard(g_mutex);
+    UpdateSnapshot([&dir](Snapshot& snapshot) {
+        snapshot.storageDir = dir;
+    });
 }
 
 bool HiAppEventConfig::GetDisable()
 {
-    std::lock_guard<std::mutex> lockGuard(g_mutex);
-    return disable_;
+    return GetSnapshot()->disable;
 }
 
 uint64_t HiAppEventConfig::GetMaxStorageSize()
 {
-    std::lock_guard<std::mutex> lockGuard(g_mutex);
-    return maxStorageSize_;
+    return GetSnapshot()->maxStorageSize;
 }
 
 std::string HiAppEventConfig::GetStorageDir()
 {
+    if (auto snapshot = GetSnapshot(); !snapshot->storageDir.empty()) {
+        return snapshot->storageDir;
+    }
     std::lock_guard<std::mutex> lockGuard(g_mutex);
-    if (!storageDir_.empty()) {
-        return storageDir_;
+    if (auto snapshot = GetSnapshot(); !snapshot->storageDir.empty()) {
+        return snapshot->storageDir;
     }
     std::shared_ptr<OHOS::AbilityRuntime::ApplicationContext> context =
         OHOS::AbilityRuntime::Context::GetApplicationContext();
@@ -236,15 +262,20 @@ std::string HiAppEventConfig::GetStorageDir()
         return "";
     }
     std::string dir = context->GetFilesDir() + APP_EVENT_DIR;
-    SetStorageDir(dir);
-    return storageDir_;
+    UpdateSnapshot([&dir](Snapshot& snapshot) {
+        snapshot.storageDir = dir;
+    });
+    return dir;
 }
 
 std::string HiAppEventConfig::GetRunningId()
 {
+    if (auto snapshot = GetSnapshot(); !snapshot->runningId.empty()) {
+        return snapshot->runningId;
+    }
     std::lock_guard<std::mutex> lockGuard(g_mutex);
-    if (!runningId_.empty()) {
-        return runningId_;
+    if (auto snapshot = GetSnapshot(); !snapshot->runningId.empty()) {
+        return snapshot->runningId;
     }
     std::shared_ptr<OHOS::AbilityRuntime::ApplicationContext> context =
         OHOS::AbilityRuntime::Context::GetApplicationContext();
@@ -252,28 +283,39 @@ std::string HiAppEventConfig::GetRunningId()
         HILOG_ERROR(LOG_CORE, "Context is null.");
         return "";
     }
-    runningId_ = context->GetAppRunningUniqueId();
-    if (runningId_.empty()) {
+    std::string runningId = context->GetAppRunningUniqueId();
+    if (runningId.empty()) {
         HILOG_ERROR(LOG_CORE, "The running id from context is empty.");
+        return runningId;
     }
-    return runningId_;
+    UpdateSnapshot([&runningId](Snapshot& snapshot) {
+        snapshot.runningId = runningId;
+    });
+    return runningId;
 }
 
 bool HiAppEventConfig::IsFreeSizeOverLimit()
 {
-    std::lock_guard<std::mutex> lockGuard(g_mutex);
-    if (!isInitFreeSize_) {
-        auto storageMgr = GetStorageMgr();
-        int64_t freeSize = -1;
-        if (storageMgr == nullptr || storageMgr->GetFreeSize(freeSize) != 0) {
-            HILOG_WARN(LOG_CORE, "Failed to get free size.");
-            return false;
+    auto snapshot = GetSnapshot();
+    if (!snapshot->isInitFreeSize) {
+        std::lock_guard<std::mutex> lockGuard(g_mutex);
+        snapshot = GetSnapshot();
+        if (!snapshot->isInitFreeSize) {
+            auto storageMgr = GetStorageMgr();
+            int64_t freeSize = -1;
+            if (storageMgr == nullptr || storageMgr->GetFreeSize(freeSize) != 0) {
+                HILOG_WARN(LOG_CORE, "Failed to get free size.");
+                return false;
+            }
+            HILOG_INFO(LOG_CORE, "get free size=%{public}" PRId64, freeSize);
+            UpdateSnapshot([freeSize](Snapshot& newSnapshot) {
+                newSnapshot.freeSize = freeSize;
+                newSnapshot.isInitFreeSize = true;
+            });
+            snapshot = GetSnapshot();
         }
-        HILOG_INFO(LOG_CORE, "get free size=%{public}" PRId64, freeSize);
-        freeSize_ = freeSize;
-        isInitFreeSize_ = true;
     }
-    return freeSize_ >= 0 && freeSize_ < FREE_SIZE_LIMIT;
+    return snapshot->freeSize >= 0 && snapshot->freeSize < FREE_SIZE_LIMIT;
 }
 
 void HiAppEventConfig::RefreshFreeSize()
@@ -286,7 +328,9 @@ void HiAppEventConfig::RefreshFreeSize()
     }
     HILOG_INFO(LOG_CORE, "refresh free size=%{public}" PRId64, freeSize);
     std::lock_guard<std::mutex> lockGuard(g_mutex);
-    freeSize_ = freeSize;
+    UpdateSnapshot([freeSize](Snapshot& snapshot) {
+        snapshot.freeSize = freeSize;
+    });
 }
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -142,6 +142,12 @@ int AppEventObserverFacade::RegisterProcessor(const std::string& name,
     return AppEventObserverMgr::GetInstance().RegisterProcessor(name, processor);
 }
 
+int AppEventObserverFacade::RegisterAsyncProcessor(const std::string& name,
+    std::shared_ptr<HiAppEvent::AppEventAsyncProcessor> processor)
+{
+    return AppEventObserverMgr::GetInstance().RegisterAsyncProcessor(name, processor);
+}
+
 int AppEventObserverFacade::UnregisterProcessor(const std::string& name)
 {
     return AppEventObserverMgr::GetInstance().UnregisterProcessor(name);
@@ -205,6 +211,16 @@ int AppEventStoreFacade::QueryEvents(std::vector<std::shared_ptr<AppEventPack>>&
     return AppEventStore::GetInstance().QueryEvents(events, observerSeq, row);
 }
 
+int AppEventStoreFacade::QueryEventsBySize(std::vector<std::shared_ptr<AppEventPack>>& events,
+    int64_t observerSeq, int size)
+{
+    // no event can be taken within the size
+    if (size <= 0) {
+        return 0;
+    }
+    return AppEventStore::GetInstance().QueryEventsBySize(events, observerSeq, static_cast<size_t>(size));
+}
+
 bool AppEventStoreFacade::DeleteData(int64_t observerSeq, const std::vector<int64_t>& eventSeqs)
 {
     return AppEventStore::GetInstance().DeleteData(observerSeq, eventSeqs);
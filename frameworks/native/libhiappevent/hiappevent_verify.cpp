@@ -199,7 +199,7 @@ bool CheckStringLengthOfList(AppEventParam& param, size_t maxTotalLen = 0)
     return true;
 }
 
-bool CheckParamsNum(std::list<AppEventParam>& baseParams)
+bool CheckParamsNum(AppEventParams& baseParams)
 {
     if (baseParams.size() == 0) {
         return true;
@@ -207,9 +207,7 @@ bool CheckParamsNum(std::list<AppEventParam>& baseParams)
 
     auto listSize = baseParams.size();
     if (listSize > MAX_NUM_OF_PARAMS) {
-        auto delStartPtr = baseParams.begin();
-        std::advance(delStartPtr, MAX_NUM_OF_PARAMS);
-        baseParams.erase(delStartPtr, baseParams.end());
+        baseParams.erase(baseParams.begin() + MAX_NUM_OF_PARAMS, baseParams.end());
         return false;
     }
 
@@ -440,16 +438,23 @@ int VerifyAppEvent(std::shared_ptr<AppEventPack> event)
     }
 
     int verifyRes = HIAPPEVENT_VERIFY_SUCCESSFUL;
-    std::list<AppEventParam>& baseParams = event->baseParams_;
+    AppEventParams& baseParams = event->baseParams_;
     std::unordered_set<std::string> paramNames;
-    for (auto it = baseParams.begin(); it != baseParams.end();) {
-        if (!VerifyAppEventParam(*it, paramNames, verifyRes)) {
-            baseParams.erase(it++);
+    // compact the valid params in place to keep their order
+    size_t validNum = 0;
+    for (size_t i = 0; i < baseParams.size(); ++i) {
+        if (!VerifyAppEventParam(baseParams[i], paramNames, verifyRes)) {
             continue;
         }
-        paramNames.emplace(it->name);
-        it++;
+        paramNames.emplace(baseParams[i].name);
+        if (validNum != i) {
+            baseParams[validNum] = std::move(baseParams[i]);
+        }
+        ++validNum;
     }
+    baseParams.erase(baseParams.begin() + validNum, baseParams.end());
+    // the params may be discarded or modified during the verification
+    event->InvalidateEventStr();
 
     if (!CheckParamsNum(baseParams)) {
         HILOG_WARN(LOG_CORE, "params that exceed 32 are discarded because the number of params cannot exceed 32.");
@@ -474,7 +479,7 @@ int VerifyCustomEventParams(std::shared_ptr<AppEventPack> event)
         return ERROR_INVALID_EVENT_NAME;
     }
 
-    std::list<AppEventParam>& baseParams = event->baseParams_;
+    AppEventParams& baseParams = event->baseParams_;
     if (baseParams.size() > MAX_NUM_OF_CUSTOM_PARAMS) {
         HILOG_WARN(LOG_CORE, "params that exceed 64 are discarded because the number of params cannot exceed 64.");
         return ERROR_INVALID_CUSTOM_PARAM_NUM;
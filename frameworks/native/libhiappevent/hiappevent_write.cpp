@@ -17,7 +17,9 @@
 
 #include <mutex>
 #include <string>
+#include <vector>
 
+#include "app_event_log_writer.h"
 #include "app_event_store.h"
 #include "app_event_observer_mgr.h"
 #include "file_util.h"
@@ -25,7 +27,6 @@
 #include "hiappevent_clean.h"
 #include "hiappevent_config.h"
 #include "hilog/log.h"
-#include "time_util.h"
 
 #undef LOG_DOMAIN
 #define LOG_DOMAIN 0xD002D07
@@ -41,32 +42,129 @@ std::mutex g_mutex;
 constexpr int SUBMIT_FAILED_NUM = 50;
 static int g_submitFailedCnt = 0;
 static std::mutex g_submitFailedCntMutex;
+constexpr uint64_t MICROSECONDS_PER_MILLISECOND = 1000;
+constexpr const char* DRAIN_TASK_NAME = "app_event_batch";
+// the max number of events waiting in the batch, the new events are dropped if the drain task falls behind
+constexpr size_t MAX_PENDING_EVENT_NUM = 10000;
+
+std::mutex g_batchMutex;
+std::vector<std::shared_ptr<AppEventPack>> g_pendingEvents;
+WriteBatchConfig g_batchConfig;
+bool g_isDrainScheduled = false;
+AppEventLogWriter g_logWriter;
 
 std::string GetStorageDirPath()
 {
     return HiAppEventConfig::GetInstance().GetStorageDir();
 }
 
-std::string GetStorageFileName()
+void SubmitDrainTask(uint64_t delayMs, const std::string& taskName = DRAIN_TASK_NAME);
+
+void DrainPendingEvents()
 {
-    return "app_event_" + TimeUtil::GetDate() + ".log";
+    std::vector<std::shared_ptr<AppEventPack>> events;
+    bool hasRestEvents = false;
+    {
+        std::lock_guard<std::mutex> lockGuard(g_batchMutex);
+        size_t maxCount = g_batchConfig.maxCount;
+        if (g_pendingEvents.size() <= maxCount) {
+            events.swap(g_pendingEvents);
+            g_isDrainScheduled = false;
+        } else {
+            events.assign(g_pendingEvents.begin(), g_pendingEvents.begin() + maxCount);
+            g_pendingEvents.erase(g_pendingEvents.begin(), g_pendingEvents.begin() + maxCount);
+            hasRestEvents = true;
+        }
+    }
+    if (hasRestEvents) {
+        // the rest of the events are handled by the next drain task immediately
+        SubmitDrainTask(0);
+    }
+    WriteEvents(events);
 }
 
-bool WriteEventToFile(const std::string& filePath, const std::string& event)
+// called without g_batchMutex, since the queue may run the task in the current thread
+void SubmitDrainTask(uint64_t delayMs, const std::string& taskName)
 {
-    return FileUtil::SaveStringToFile(filePath, event);
+    if (AppEventObserverMgr::GetInstance().SubmitTaskToFFRTQueue(DrainPendingEvents, taskName,
+        delayMs * MICROSECONDS_PER_MILLISECOND)) {
+        return;
+    }
+    // no drain task is scheduled any more, so the events of the batch are dropped as the single event before
+    size_t droppedNum = 0;
+    {
+        std::lock_guard<std::mutex> lockGuard(g_batchMutex);
+        droppedNum = g_pendingEvents.size();
+        g_pendingEvents.clear();
+        g_isDrainScheduled = false;
+    }
+    HILOG_ERROR(LOG_CORE, "failed to submit the drain task, drop %{public}zu events.", droppedNum);
 }
 }
 
 void SubmitWritingTask(std::shared_ptr<AppEventPack> appEventPack, const std::string& taskName)
 {
-    AppEventObserverMgr::GetInstance().SubmitTaskToFFRTQueue([appEventPack]() {
-        WriteEvent(appEventPack);
-        }, taskName);
+    if (appEventPack == nullptr) {
+        HILOG_ERROR(LOG_CORE, "appEventPack is null, task=%{public}s.", taskName.c_str());
+        return;
+    }
+    uint64_t delayMs = 0;
+    {
+        std::lock_guard<std::mutex> lockGuard(g_batchMutex);
+        if (g_pendingEvents.size() >= MAX_PENDING_EVENT_NUM) {
+            HILOG_WARN(LOG_CORE, "too many pending events, drop the event, task=%{public}s.", taskName.c_str());
+            return;
+        }
+        g_pendingEvents.emplace_back(appEventPack);
+        if (g_isDrainScheduled) {
+            // the scheduled task will take the event away, and submits the next one if the batch is full
+            return;
+        }
+        g_isDrainScheduled = true;
+        // the batch is full, do not wait for the latency, e.g. the max count is lowered by SetWriteBatchConfig
+        delayMs = g_pendingEvents.size() >= g_batchConfig.maxCount ? 0 : g_batchConfig.maxLatencyMs;
+    }
+    SubmitDrainTask(delayMs, taskName);
+}
+
+void SetWriteBatchConfig(const WriteBatchConfig& config)
+{
+    if (config.maxCount == 0) {
+        HILOG_WARN(LOG_CORE, "invalid batch max count=0.");
+        return;
+    }
+    std::lock_guard<std::mutex> lockGuard(g_batchMutex);
+    g_batchConfig = config;
+}
+
+WriteBatchConfig GetWriteBatchConfig()
+{
+    std::lock_guard<std::mutex> lockGuard(g_batchMutex);
+    return g_batchConfig;
+}
+
+void SetLogWriterConfig(const LogWriterConfig& config)
+{
+    std::lock_guard<std::mutex> lockGuard(g_mutex);
+    g_logWriter.SetConfig(config);
 }
 
 void WriteEvent(std::shared_ptr<AppEventPack> appEventPack)
 {
+    if (appEventPack == nullptr) {
+        HILOG_ERROR(LOG_CORE, "appEventPack is null.");
+        return;
+    }
+    std::vector<std::shared_ptr<AppEventPack>> events;
+    events.emplace_back(appEventPack);
+    WriteEvents(events);
+}
+
+void WriteEvents(std::vector<std::shared_ptr<AppEventPack>>& events)
+{
+    if (events.empty()) {
+        return;
+    }
     if (HiAppEventConfig::GetInstance().GetDisable()) {
         HILOG_WARN(LOG_CORE, "the HiAppEvent function is disabled.");
         return;
@@ -75,33 +173,33 @@ void WriteEvent(std::shared_ptr<AppEventPack> appEventPack)
         HILOG_WARN(LOG_CORE, "Write:free size over limit.");
         return;
     }
-    if (appEventPack == nullptr) {
-        HILOG_ERROR(LOG_CORE, "appEventPack is null.");
-        return;
-    }
     std::string dirPath = GetStorageDirPath();
     if (dirPath.empty()) {
         HILOG_ERROR(LOG_CORE, "dirPath is null, stop writing the event.");
         return;
     }
-    std::string event = appEventPack->GetEventStr();
-    HILOG_DEBUG(LOG_CORE, "WriteEvent domain=%{public}s, name=%{public}s.",
-        appEventPack->GetDomain().c_str(), appEventPack->GetName().c_str());
+    std::vector<std::string> contents;
+    contents.reserve(events.size());
+    uint64_t writeSize = 0;
+    for (const auto& event : events) {
+        contents.emplace_back(event->GetEventStr());
+        writeSize += contents.back().size();
+    }
+    HILOG_DEBUG(LOG_CORE, "WriteEvents size=%{public}zu, first domain=%{public}s, name=%{public}s.",
+        events.size(), events.front()->GetDomain().c_str(), events.front()->GetName().c_str());
     {
         std::lock_guard<std::mutex> lockGuard(g_mutex);
         if (!FileUtil::IsFileExists(dirPath) && !FileUtil::ForceCreateDirectory(dirPath)) {
             HILOG_ERROR(LOG_CORE, "failed to create hiappevent dir, errno=%{public}d.", errno);
             return;
         }
-        HiAppEventClean::CheckStorageSpace();
-        std::string filePath = FileUtil::GetFilePathByDir(dirPath, GetStorageFileName());
-        if (!WriteEventToFile(filePath, event)) {
-            HILOG_ERROR(LOG_CORE, "failed to write event to log file, errno=%{public}d.", errno);
+        HiAppEventClean::CheckStorageSpace(events.size());
+        if (!g_logWriter.Write(dirPath, contents)) {
+            HILOG_ERROR(LOG_CORE, "failed to write event to log file, errno=%{public}d.", g_logWriter.GetLastErrno());
             return;
         }
+        HiAppEventClean::AddStorageSize(writeSize);
     }
-    std::vector<std::shared_ptr<AppEventPack>> events;
-    events.emplace_back(appEventPack);
     AppEventObserverMgr::GetInstance().HandleEvents(events);
 }
 
@@ -16,7 +16,8 @@
 #ifndef HI_APP_EVENT_BASE_H
 #define HI_APP_EVENT_BASE_H
 
-#include <list>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <variant>
 #include <vector>
@@ -103,10 +104,16 @@ struct AppEventParam {
 
     AppEventParam(std::string n, AppEventParamValue v);
     AppEventParam(const AppEventParam& param);
+    AppEventParam(AppEventParam&& param) noexcept;
+    AppEventParam& operator=(const AppEventParam& param);
+    AppEventParam& operator=(AppEventParam&& param) noexcept;
     ~AppEventParam();
 };
 using AppEventParam = struct AppEventParam;
 
+// the params are stored contiguously in the order of adding
+using AppEventParams = std::vector<AppEventParam>;
+
 struct CustomEventParam {
     std::string key;
     std::string value;
@@ -114,6 +121,29 @@ struct CustomEventParam {
 };
 using CustomEventParam = struct CustomEventParam;
 
+/*
+ * The interned string of an event domain or name, the same string is shared by all the events and has the same id.
+ * The symbols are never released, so the number of the interned strings is limited, and the string beyond the
+ * limit is owned by the symbol with an invalid id.
+ */
+class AppEventSymbol {
+public:
+    static constexpr uint32_t INVALID_ID = UINT32_MAX;
+
+    AppEventSymbol();
+    explicit AppEventSymbol(const std::string& str, bool isForced = false);
+    ~AppEventSymbol() = default;
+    uint32_t GetId() const;
+    const std::string& GetStr() const;
+
+    // gets the id of the interned string without interning it, returns INVALID_ID if it is not interned
+    static uint32_t FindId(const std::string& str);
+
+private:
+    uint32_t id_ = INVALID_ID;
+    std::shared_ptr<const std::string> str_;
+};
+
 class AppEventPack {
 public:
     AppEventPack() = default;
@@ -146,8 +176,12 @@ public:
     void AddCustomParams(const std::unordered_map<std::string, std::string>& customParams);
 
     int64_t GetSeq() const;
-    std::string GetDomain() const;
-    std::string GetName() const;
+    const std::string& GetDomain() const;
+    const std::string& GetName() const;
+    const AppEventSymbol& GetDomainSymbol() const;
+    const AppEventSymbol& GetNameSymbol() const;
+    uint32_t GetDomainId() const;
+    uint32_t GetNameId() const;
     int GetType() const;
     uint64_t GetTime() const;
     std::string GetTimeZone() const;
@@ -158,9 +192,11 @@ public:
     int64_t GetPspanId() const;
     int GetTraceFlag() const;
     std::string GetEventStr() const;
+    size_t GetEventSize() const;
     std::string GetParamStr() const;
     std::string GetRunningId() const;
-    std::list<AppEventParam> GetBaseParams() const;
+    const AppEventParams& GetBaseParams() const;
+    AppEventParams TakeBaseParams();
     void GetCustomParams(std::vector<CustomEventParam>& customParams) const;
 
     void SetSeq(int64_t seq);
@@ -176,7 +212,8 @@ public:
     void SetPspanId(int64_t pspanId);
     void SetTraceFlag(int traceFlag);
     void SetRunningId(const std::string& runningId);
-    void SetBaseParams(const std::list<AppEventParam>& baseParams);
+    void SetBaseParams(const AppEventParams& baseParams);
+    void SetBaseParams(AppEventParams&& baseParams);
     void SetParamStr(const std::string& paramStr);
 
     friend int VerifyAppEvent(std::shared_ptr<AppEventPack> appEventPack);
@@ -188,15 +225,17 @@ private:
     void InitProcessInfo();
     void InitTraceInfo();
     void InitRunningId();
-    void AddBaseInfoToJsonString(std::stringstream& jsonStr) const;
-    void AddTraceInfoToJsonString(std::stringstream& jsonStr) const;
-    void AddParamsInfoToJsonString(std::stringstream& jsonStr) const;
-    void AddParamsToJsonString(std::stringstream& jsonStr) const;
+    std::shared_ptr<const std::string> GetEventStrCache() const;
+    void InvalidateEventStr();
+    void AddBaseInfoToJsonString(std::string& jsonStr) const;
+    void AddTraceInfoToJsonString(std::string& jsonStr) const;
+    void AddParamsInfoToJsonString(std::string& jsonStr) const;
+    void AddParamsToJsonString(std::string& jsonStr) const;
 
 private:
     int64_t seq_ = 0;
-    std::string domain_;
-    std::string name_;
+    AppEventSymbol domain_;
+    AppEventSymbol name_;
     int type_ = 0;
     uint64_t time_ = 0;
     std::string timeZone_;
@@ -207,8 +246,11 @@ private:
     int64_t pspanId_ = 0;
     int traceFlag_ = 0;
     std::string runningId_;
-    std::list<AppEventParam> baseParams_;
+    AppEventParams baseParams_;
     std::string paramStr_;
+
+    // the serialized event string, cleared whenever the content of the event is changed
+    mutable std::shared_ptr<const std::string> eventStrCache_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
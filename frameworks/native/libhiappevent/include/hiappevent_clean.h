@@ -25,7 +25,15 @@ namespace HiAppEventClean {
 bool IsStorageSpaceFull(const std::string& dir, uint64_t maxSize);
 bool ReleaseSomeStorageSpace(const std::string& dir, uint64_t maxSize);
 void ClearData(const std::string& dir);
-void CheckStorageSpace();
+
+// accounts the size of the data appended to the log files of the storage dir
+void AddStorageSize(uint64_t size);
+
+// gets the accounted size of the storage dir, the dir is only scanned when the accounting starts
+uint64_t GetStorageSize();
+
+// the storage space is released asynchronously when the accounted size exceeds the max storage size
+void CheckStorageSpace(size_t eventNum = 1);
 } // namespace HiAppEventClean
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -15,6 +15,8 @@
 #ifndef HI_APP_EVENT_CONFIG_H
 #define HI_APP_EVENT_CONFIG_H
 
+#include <cstdint>
+#include <memory>
 #include <string>
 
 #include "nocopyable.h"
@@ -34,7 +36,17 @@ public:
     void RefreshFreeSize();
 
 private:
-    HiAppEventConfig() {}
+    // the immutable config read by the event writing without locking, a new one is published on every change
+    struct Snapshot {
+        bool disable = false;
+        int64_t freeSize = -1;
+        bool isInitFreeSize = false;
+        uint64_t maxStorageSize = 10 * 1024 * 1024; // max storage size is 10M, 10 * 1024 * 1024 Byte
+        std::string storageDir = "";
+        std::string runningId = "";
+    };
+
+    HiAppEventConfig();
     ~HiAppEventConfig() {}
     HiAppEventConfig(const HiAppEventConfig&);
     HiAppEventConfig& operator=(const HiAppEventConfig&);
@@ -42,14 +54,12 @@ private:
     bool SetMaxStorageSizeItem(const std::string& value);
     void SetDisable(bool disable);
     void SetMaxStorageSize(uint64_t size);
+    std::shared_ptr<const Snapshot> GetSnapshot() const;
+    template<typename Func>
+    void UpdateSnapshot(Func&& func);
 
 private:
-    bool disable_ = false;
-    int64_t freeSize_ = -1;
-    bool isInitFreeSize_ = false;
-    uint64_t maxStorageSize_ = 10 * 1024 * 1024; // max storage size is 10M, 10 * 1024 * 1024 Byte
-    std::string storageDir_ = "";
-    std::string runningId_ = "";
+    std::shared_ptr<const Snapshot> snapshot_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
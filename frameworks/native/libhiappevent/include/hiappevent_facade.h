@@ -62,6 +62,8 @@ public:
     static int64_t AddWatcher(std::shared_ptr<AppEventWatcher> watcher);
     static void SubmitTaskToFFRTQueue(std::function<void()>&& task, const std::string& taskName);
     static int RegisterProcessor(const std::string& name, std::shared_ptr<HiAppEvent::AppEventProcessor> processor);
+    static int RegisterAsyncProcessor(const std::string& name,
+        std::shared_ptr<HiAppEvent::AppEventAsyncProcessor> processor);
     static int UnregisterProcessor(const std::string& name);
     static int SetReportConfig(int64_t observerSeq, const HiAppEvent::ReportConfig& config);
     static int GetReportConfig(int64_t observerSeq, HiAppEvent::ReportConfig& config);
@@ -82,6 +84,7 @@ public:
 class AppEventStoreFacade {
 public:
     static int QueryEvents(std::vector<std::shared_ptr<AppEventPack>>& events, int64_t observerSeq, int row = 0);
+    static int QueryEventsBySize(std::vector<std::shared_ptr<AppEventPack>>& events, int64_t observerSeq, int size);
     static bool DeleteData(int64_t observerSeq, const std::vector<int64_t>& eventSeqs);
     static int DeleteEventMapping(int64_t observerSeq, const std::vector<int64_t>& eventSeqs);
     static int64_t QueryObserverSeq(const std::string& name);
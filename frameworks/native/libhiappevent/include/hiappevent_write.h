@@ -15,14 +15,30 @@
 
 #ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_HIAPPEVENT_WRITE_H
 #define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_INCLUDE_HIAPPEVENT_WRITE_H
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace OHOS {
 namespace HiviewDFX {
 class AppEventPack;
+struct LogWriterConfig;
+
+struct WriteBatchConfig {
+    /* the max number of events written by one batch */
+    size_t maxCount = 100;
+
+    /* the max time in milliseconds that an event waits in the batch before being written */
+    uint64_t maxLatencyMs = 20;
+};
 
 void SubmitWritingTask(std::shared_ptr<AppEventPack> appEventPack, const std::string& taskName);
+void SetWriteBatchConfig(const WriteBatchConfig& config);
+WriteBatchConfig GetWriteBatchConfig();
+void SetLogWriterConfig(const LogWriterConfig& config);
 void WriteEvent(std::shared_ptr<AppEventPack> appEventPack);
+void WriteEvents(std::vector<std::shared_ptr<AppEventPack>>& events);
 int SetEventParam(std::shared_ptr<AppEventPack> appEventPack);
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -30,7 +30,8 @@ public:
     ~ModuleLoader();
     int Load(const std::string& moduleName);
     int Unload(const std::string& moduleName);
-    int RegisterProcessor(const std::string& name, std::shared_ptr<AppEventProcessor> processor);
+    int RegisterProcessor(const std::string& name, std::shared_ptr<AppEventProcessor> processor,
+        std::shared_ptr<AppEventAsyncProcessor> asyncProcessor = nullptr);
     int UnregisterProcessor(const std::string& name);
     std::shared_ptr<AppEventProcessorProxy> CreateProcessorProxy(const std::string& name);
 
@@ -39,6 +40,8 @@ private:
     std::unordered_map<std::string, void*> modules_;
     /* <processor name, processor object> */
     std::unordered_map<std::string, std::shared_ptr<AppEventProcessor>> processors_;
+    /* <processor name, processor object>, only for the asynchronous processors */
+    std::unordered_map<std::string, std::shared_ptr<AppEventAsyncProcessor>> asyncProcessors_;
     std::mutex moduleMutex_;
     std::mutex processorMutex_;
 };
@@ -96,7 +96,8 @@ int ModuleLoader::Unload(const std::string& moduleName)
     return 0;
 }
 
-int ModuleLoader::RegisterProcessor(const std::string& name, std::shared_ptr<AppEventProcessor> processor)
+int ModuleLoader::RegisterProcessor(const std::string& name, std::shared_ptr<AppEventProcessor> processor,
+    std::shared_ptr<AppEventAsyncProcessor> asyncProcessor)
 {
     if (name.empty() || processor == nullptr) {
         HILOG_WARN(LOG_CORE, "the name or processor is invalid");
@@ -108,6 +109,9 @@ int ModuleLoader::RegisterProcessor(const std::string& name, std::shared_ptr<App
         return -1;
     }
     processors_[name] = processor;
+    if (asyncProcessor != nullptr) {
+        asyncProcessors_[name] = asyncProcessor;
+    }
     return 0;
 }
 
@@ -119,6 +123,7 @@ int ModuleLoader::UnregisterProcessor(const std::string& name)
         return -1;
     }
     processors_.erase(name);
+    asyncProcessors_.erase(name);
     return 0;
 }
 
@@ -129,7 +134,9 @@ std::shared_ptr<AppEventProcessorProxy> ModuleLoader::CreateProcessorProxy(const
         HILOG_WARN(LOG_CORE, "the name is invalid");
         return nullptr;
     }
-    return std::make_shared<AppEventProcessorProxy>(name, processors_[name]);
+    auto it = asyncProcessors_.find(name);
+    return std::make_shared<AppEventProcessorProxy>(name, processors_[name],
+        it != asyncProcessors_.end() ? it->second : nullptr);
 }
 } // namespace HiAppEvent
 } // namespace HiviewDFX
@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "app_event_dispatcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+
+#include "ffrt.h"
+#include "hiappevent_base.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr const char* DELIVER_TASK_NAME = "app_event_deliver";
+}
+
+// at most one delivering task of a channel is submitted at a time, so the events are delivered serially
+class AppEventDispatcher::Channel : public std::enable_shared_from_this<AppEventDispatcher::Channel> {
+public:
+    Channel(std::shared_ptr<AppEventObserver> observer, const DispatchConfig& config,
+        AppEventDispatcher::DeliveredCallback callback)
+        : observer_(observer), config_(config), callback_(callback)
+    {}
+    ~Channel() = default;
+
+    void Push(std::vector<std::shared_ptr<AppEventPack>>&& events)
+    {
+        // checked outside of the lock, since the observer may take its own lock
+        std::vector<bool> realTimeFlags;
+        realTimeFlags.reserve(events.size());
+        for (const auto& event : events) {
+            realTimeFlags.emplace_back(observer_->IsRealTimeEvent(event));
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < events.size(); ++i) {
+            if (!realTimeFlags[i] && events_.size() >= config_.maxQueueSize && !HandleOverflow(events[i])) {
+                continue;
+            }
+            events_.push_back({ std::move(events[i]), realTimeFlags[i] });
+        }
+        stats_.queueDepth = events_.size();
+        stats_.maxQueueDepth = std::max(stats_.maxQueueDepth, stats_.queueDepth);
+        if (!isScheduled_ && (!events_.empty() || spilledCond_.row > 0)) {
+            isScheduled_ = true;
+            auto self = shared_from_this();
+            ffrt::submit([self] {
+                self->Deliver();
+                }, ffrt::task_attr().name(DELIVER_TASK_NAME));
+        }
+    }
+
+    void SetConfig(const DispatchConfig& config)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        config_ = config;
+    }
+
+    DispatchStats GetStats()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.clear();
+        spilledCond_ = {};
+        stats_.queueDepth = 0;
+    }
+
+    void Close()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isClosed_ = true;
+        events_.clear();
+        spilledCond_ = {};
+        stats_.queueDepth = 0;
+    }
+
+    bool WaitIdle(std::chrono::steady_clock::time_point deadline)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cond_.wait_until(lock, deadline, [this] { return !isScheduled_; });
+    }
+
+private:
+    // returns true if the non-real-time event is pushed into the queue after the overflow is handled
+    bool HandleOverflow(const std::shared_ptr<AppEventPack>& event)
+    {
+        if (config_.overflowPolicy == DispatchOverflowPolicy::DROP_OLDEST) {
+            auto it = std::find_if(events_.begin(), events_.end(), [](const QueuedEvent& queuedEvent) {
+                return !queuedEvent.isRealTime;
+            });
+            if (it != events_.end()) {
+                events_.erase(it);
+                ++stats_.droppedNum;
+                return true;
+            }
+            // the queue is full of the real-time events, so the event is spilled
+        }
+        ++spilledCond_.row;
+        spilledCond_.size += static_cast<int>(event->GetEventSize());
+        ++stats_.spilledNum;
+        return false;
+    }
+
+    void Deliver()
+    {
+        while (true) {
+            std::vector<std::shared_ptr<AppEventPack>> events;
+            std::vector<std::shared_ptr<AppEventPack>> realTimeEvents;
+            HiAppEvent::TriggerCondition spilledCond;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (isClosed_ || (events_.empty() && spilledCond_.row == 0)) {
+                    isScheduled_ = false;
+                    cond_.notify_all();
+                    return;
+                }
+                for (auto& queuedEvent : events_) {
+                    auto& target = queuedEvent.isRealTime ? realTimeEvents : events;
+                    target.emplace_back(std::move(queuedEvent.event));
+                }
+                stats_.deliveredNum += events_.size();
+                events_.clear();
+                spilledCond = spilledCond_;
+                spilledCond_ = {};
+                stats_.queueDepth = 0;
+            }
+            for (const auto& event : events) {
+                observer_->ProcessEvent(event);
+            }
+            if (!realTimeEvents.empty()) {
+                observer_->OnEvents(realTimeEvents);
+            }
+            if (spilledCond.row > 0) {
+                observer_->ProcessEvents(spilledCond.row, spilledCond.size);
+            }
+            if (callback_ != nullptr) {
+                callback_(observer_);
+            }
+        }
+    }
+
+private:
+    struct QueuedEvent {
+        std::shared_ptr<AppEventPack> event;
+
+        /* Whether the event is delivered by OnEvents, which can not be taken from the db again */
+        bool isRealTime = false;
+    };
+
+    std::shared_ptr<AppEventObserver> observer_;
+    DispatchConfig config_;
+    AppEventDispatcher::DeliveredCallback callback_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<QueuedEvent> events_;
+    HiAppEvent::TriggerCondition spilledCond_;
+    DispatchStats stats_;
+    bool isScheduled_ = false;
+    bool isClosed_ = false;
+};
+
+AppEventDispatcher::AppEventDispatcher(DeliveredCallback callback) : callback_(callback)
+{}
+
+void AppEventDispatcher::Dispatch(std::shared_ptr<AppEventObserver> observer,
+    std::vector<std::shared_ptr<AppEventPack>>&& events)
+{
+    if (observer == nullptr || events.empty()) {
+        return;
+    }
+    std::shared_ptr<Channel> channel;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = channels_.find(observer->GetSeq());
+        if (it == channels_.end()) {
+            // the observer is removed after the events are routed, the events are not delivered to it any more
+            return;
+        }
+        channel = it->second;
+    }
+    channel->Push(std::move(events));
+}
+
+void AppEventDispatcher::AddObserver(std::shared_ptr<AppEventObserver> observer)
+{
+    if (observer == nullptr) {
+        return;
+    }
+    int64_t observerSeq = observer->GetSeq();
+    std::shared_ptr<Channel> oldChannel;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        DispatchConfig config;
+        if (auto it = configs_.find(observerSeq); it != configs_.end()) {
+            config = it->second;
+        }
+        auto& channel = channels_[observerSeq];
+        oldChannel = channel;
+        channel = std::make_shared<Channel>(observer, config, callback_);
+    }
+    // the observer registered again with the same seq replaces the old one
+    if (oldChannel != nullptr) {
+        oldChannel->Close();
+    }
+}
+
+void AppEventDispatcher::SetConfig(int64_t observerSeq, const DispatchConfig& config)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    configs_[observerSeq] = config;
+    if (auto it = channels_.find(observerSeq); it != channels_.end()) {
+        it->second->SetConfig(config);
+    }
+}
+
+bool AppEventDispatcher::GetStats(int64_t observerSeq, DispatchStats& stats)
+{
+    std::shared_ptr<Channel> channel;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = channels_.find(observerSeq);
+        if (it == channels_.end()) {
+            return false;
+        }
+        channel = it->second;
+    }
+    stats = channel->GetStats();
+    return true;
+}
+
+void AppEventDispatcher::RemoveObserver(int64_t observerSeq)
+{
+    std::shared_ptr<Channel> channel;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        configs_.erase(observerSeq);
+        auto it = channels_.find(observerSeq);
+        if (it == channels_.end()) {
+            return;
+        }
+        channel = it->second;
+        channels_.erase(it);
+    }
+    // the events waiting in the queue are not delivered to the removed observer
+    channel->Close();
+}
+
+void AppEventDispatcher::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [seq, channel] : channels_) {
+        channel->Clear();
+    }
+}
+
+bool AppEventDispatcher::WaitIdle(uint64_t timeoutMs)
+{
+    std::vector<std::shared_ptr<Channel>> channels;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [seq, channel] : channels_) {
+            channels.emplace_back(channel);
+        }
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    return std::all_of(channels.begin(), channels.end(), [deadline](const auto& channel) {
+        return channel->WaitIdle(deadline);
+    });
+}
+
+void AppEventDispatcher::SendEvents(const std::vector<std::shared_ptr<AppEventPack>>& events,
+    std::shared_ptr<AppEventObserver> observer)
+{
+    std::vector<std::shared_ptr<AppEventPack>> realTimeEvents;
+    for (const auto& event : events) {
+        if (observer->IsRealTimeEvent(event)) {
+            realTimeEvents.emplace_back(event);
+        } else {
+            observer->ProcessEvent(event);
+        }
+    }
+    if (!realTimeEvents.empty()) {
+        observer->OnEvents(realTimeEvents);
+    }
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -14,6 +14,8 @@
  */
 #include "app_event_observer.h"
 
+#include <atomic>
+
 #include "app_event.h"
 #include "hiappevent_base.h"
 #include "hiappevent_common.h"
@@ -30,6 +32,8 @@ namespace HiviewDFX {
 namespace HiAppEvent {
 namespace {
 constexpr uint64_t BIT_MASK = 1;
+constexpr int64_t MILLISECONDS_PER_SECOND = 1000;
+std::atomic<uint64_t> g_filtersVersion = 0;
 struct OsEventPosInfo {
     std::string name;
     EventType type;
@@ -107,49 +111,62 @@ uint64_t AppEventFilter::GetOsEventsMask() const
 
 bool AppEventObserver::VerifyEvent(std::shared_ptr<AppEventPack> event)
 {
-    std::lock_guard<std::mutex> lockGuard(mutex_);
-    if (filters_.empty()) {
-        return true;
+    {
+        std::lock_guard<std::mutex> lockGuard(mutex_);
+        auto it = std::find_if(filters_.begin(), filters_.end(), [event](const auto& filter) {
+            return filter.IsValidEvent(event);
+        });
+        if (!filters_.empty() && it == filters_.end()) {
+            return false;
+        }
     }
-    auto it = std::find_if(filters_.begin(), filters_.end(), [event](const auto& filter) {
-        return filter.IsValidEvent(event);
-    });
-    return it != filters_.end();
+    return ValidateEvent(event);
 }
 
 void AppEventObserver::ProcessEvent(std::shared_ptr<AppEventPack> event)
 {
     HILOG_DEBUG(LOG_CORE, "observer=%{public}s start to process event", name_.c_str());
+    ProcessEvents(1, static_cast<int>(event->GetEventSize())); // 1 for one event
+}
+
+void AppEventObserver::ProcessEvents(int row, int size)
+{
     std::lock_guard<std::mutex> lockGuard(condMutex_);
-    ++currCond_.row;
-    currCond_.size += static_cast<int>(event->GetEventStr().size());
+    currCond_.row += row;
+    currCond_.size += size;
     if (MeetNumberCondition(currCond_.row, triggerCond_.row)
         || MeetNumberCondition(currCond_.size, triggerCond_.size)) {
         OnTrigger(currCond_);
-        ResetCondition(currCond_);
+        ClearCurrCondition();
     }
 }
 
 void AppEventObserver::ResetCurrCondition()
 {
     std::lock_guard<std::mutex> lockGuard(condMutex_);
-    ResetCondition(currCond_);
+    ClearCurrCondition();
 }
 
-void AppEventObserver::ProcessTimeout()
+void AppEventObserver::ProcessTimeout(int64_t now)
 {
     std::lock_guard<std::mutex> lockGuard(condMutex_);
-    currCond_.timeout += TIMEOUT_STEP;
-    if (MeetNumberCondition(currCond_.timeout, triggerCond_.timeout) && currCond_.row > 0) {
+    if (timeoutDeadline_ > 0 && now >= timeoutDeadline_ && currCond_.row > 0) {
+        currCond_.timeout = triggerCond_.timeout;
         OnTrigger(currCond_);
-        ResetCondition(currCond_);
+        ClearCurrCondition();
     }
 }
 
-bool AppEventObserver::HasTimeoutCondition()
+int64_t AppEventObserver::GetTimeoutDeadline(int64_t now)
 {
     std::lock_guard<std::mutex> lockGuard(condMutex_);
-    return triggerCond_.timeout > 0 && currCond_.row > 0;
+    if (triggerCond_.timeout <= 0 || currCond_.row <= 0) {
+        return 0;
+    }
+    if (timeoutDeadline_ == 0) {
+        timeoutDeadline_ = now + static_cast<int64_t>(triggerCond_.timeout) * MILLISECONDS_PER_SECOND;
+    }
+    return timeoutDeadline_;
 }
 
 void AppEventObserver::ProcessStartup()
@@ -157,7 +174,7 @@ void AppEventObserver::ProcessStartup()
     std::lock_guard<std::mutex> lockGuard(condMutex_);
     if (triggerCond_.onStartup && currCond_.row > 0) {
         OnTrigger(currCond_);
-        ResetCondition(currCond_);
+        ClearCurrCondition();
     }
 }
 
@@ -166,7 +183,7 @@ void AppEventObserver::ProcessBackground()
     std::lock_guard<std::mutex> lockGuard(condMutex_);
     if (triggerCond_.onBackground && currCond_.row > 0) {
         OnTrigger(currCond_);
-        ResetCondition(currCond_);
+        ClearCurrCondition();
     }
 }
 
@@ -198,6 +215,14 @@ void AppEventObserver::SetTriggerCond(const TriggerCondition& triggerCond)
 {
     std::lock_guard<std::mutex> lockGuard(condMutex_);
     triggerCond_ = triggerCond;
+    // the deadline is started again by the new period
+    timeoutDeadline_ = 0;
+}
+
+void AppEventObserver::ClearCurrCondition()
+{
+    ResetCondition(currCond_);
+    timeoutDeadline_ = 0;
 }
 
 std::vector<AppEventFilter> AppEventObserver::GetFilters()
@@ -210,12 +235,19 @@ void AppEventObserver::SetFilters(const std::vector<AppEventFilter>& filters)
 {
     std::lock_guard<std::mutex> lockGuard(mutex_);
     filters_ = filters;
+    ++g_filtersVersion;
 }
 
 void AppEventObserver::AddFilter(const AppEventFilter& filter)
 {
     std::lock_guard<std::mutex> lockGuard(mutex_);
     filters_.emplace_back(filter);
+    ++g_filtersVersion;
+}
+
+uint64_t AppEventObserver::GetFiltersVersion()
+{
+    return g_filtersVersion;
 }
 } // namespace HiAppEvent
 } // namespace HiviewDFX
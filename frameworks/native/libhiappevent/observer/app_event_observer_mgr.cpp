@@ -14,6 +14,10 @@
  */
 #include "app_event_observer_mgr.h"
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include "app_state_callback.h"
 #include "app_event_processor_proxy.h"
 #include "app_event_store.h"
@@ -24,6 +28,7 @@
 #include "hiappevent_config.h"
 #include "hilog/log.h"
 #include "os_event_listener.h"
+#include "time_util.h"
 
 #undef LOG_DOMAIN
 #define LOG_DOMAIN 0xD002D07
@@ -38,20 +43,19 @@ using HiAppEvent::TriggerCondition;
 using namespace AppEventCacheCommon;
 namespace {
 constexpr int REFRESH_FREE_SIZE_INTERVAL = 10 * 60 * 1000; // 10 minutes
-constexpr int TIMEOUT_INTERVAL_MILLI = HiAppEvent::TIMEOUT_STEP * 1000; // 30s
 constexpr int MAX_SIZE_OF_INIT = 100;
 constexpr int TIMEOUT_LIMIT_FOR_ADDPROCESSOR = 500;
 constexpr int CHECK_DB_INTERVAL = 1;
 
-void StoreEventsToDb(std::vector<std::shared_ptr<AppEventPack>>& events)
+void StoreEventsToDb(std::vector<std::shared_ptr<AppEventPack>>& events,
+    const std::vector<std::vector<int64_t>>& observerSeqs)
 {
+    // the events and their mapping records are stored in one transaction
+    if (AppEventStore::GetInstance().InsertEvents(events, observerSeqs) != DB_SUCC) {
+        HILOG_WARN(LOG_CORE, "failed to store events to db, size=%{public}zu", events.size());
+        return;
+    }
     for (auto& event : events) {
-        int64_t eventSeq = AppEventStore::GetInstance().InsertEvent(event);
-        if (eventSeq <= 0) {
-            HILOG_WARN(LOG_CORE, "failed to store event to db");
-            continue;
-        }
-        event->SetSeq(eventSeq);
         AppEventStore::GetInstance().QueryCustomParamsAdd2EventPack(event);
     }
 }
@@ -75,20 +79,18 @@ void StoreEventMappingToDb(const std::vector<std::shared_ptr<AppEventPack>>& eve
 void SendEventsToObserver(const std::vector<std::shared_ptr<AppEventPack>>& events,
     std::shared_ptr<AppEventObserver> observer)
 {
-    std::vector<std::shared_ptr<AppEventPack>> realTimeEvents;
-    for (const auto& event : events) {
-        if (!observer->VerifyEvent(event)) {
-            continue;
-        }
-        if (observer->IsRealTimeEvent(event)) {
-            realTimeEvents.emplace_back(event);
-        } else {
-            observer->ProcessEvent(event);
-        }
-    }
-    if (!realTimeEvents.empty()) {
-        observer->OnEvents(realTimeEvents);
-    }
+    AppEventDispatcher::SendEvents(events, observer);
+}
+
+void SetEventFilterToDb(std::shared_ptr<AppEventObserver> observer)
+{
+    // the pending events are matched in the same way as the routing of the new events
+    std::weak_ptr<AppEventObserver> weakObserver = observer;
+    auto filter = [weakObserver](std::shared_ptr<AppEventPack> event) {
+        auto observer = weakObserver.lock();
+        return observer != nullptr && observer->VerifyEvent(event);
+    };
+    AppEventStore::GetInstance().SetEventFilter(observer->GetSeq(), filter);
 }
 
 int64_t StoreObserverToDb(std::shared_ptr<AppEventObserver> observer, const std::string& filters, int64_t hashCode)
@@ -100,6 +102,7 @@ int64_t StoreObserverToDb(std::shared_ptr<AppEventObserver> observer, const std:
         return -1;
     }
     observer->SetSeq(observerSeq);
+    SetEventFilterToDb(observer);
     return observerSeq;
 }
 
@@ -111,23 +114,29 @@ int64_t InitObserverFromDb(std::shared_ptr<AppEventObserver> observer, const std
             observer->GetName().c_str(), hashCode);
         return StoreObserverToDb(observer, filters, hashCode);
     }
+    SetEventFilterToDb(observer);
+    if (hashCode != 0) {
+        // only the number and the size of the old events are needed by the processor
+        int64_t row = 0;
+        int64_t size = 0;
+        if (AppEventStore::GetInstance().QueryPendingEvents(observerSeq, row, size) < 0) {
+            HILOG_ERROR(LOG_CORE, "failed to query pending events, seq=%{public}" PRId64, observerSeq);
+            return -1;
+        }
+        TriggerCondition triggerCond;
+        triggerCond.row = static_cast<int>(std::min<int64_t>(row, std::numeric_limits<int>::max()));
+        triggerCond.size = static_cast<int>(std::min<int64_t>(size, std::numeric_limits<int>::max()));
+        observer->SetCurrCondition(triggerCond);
+        return observerSeq;
+    }
     std::vector<std::shared_ptr<AppEventPack>> events;
     if (AppEventStore::GetInstance().QueryEvents(events, observerSeq, MAX_SIZE_OF_INIT) < 0) {
         HILOG_ERROR(LOG_CORE, "failed to take events, seq=%{public}" PRId64, observerSeq);
         return -1;
     }
     if (!events.empty()) {
-        if (hashCode == 0) {
-            // send old events to watcher where init
-            SendEventsToObserver(events, observer);
-        } else {
-            TriggerCondition triggerCond;
-            for (auto event : events) {
-                triggerCond.row++;
-                triggerCond.size += static_cast<int>(event->GetEventStr().size());
-            }
-            observer->SetCurrCondition(triggerCond);
-        }
+        // send old events to watcher where init
+        SendEventsToObserver(events, observer);
     }
     return observerSeq;
 }
@@ -144,6 +153,10 @@ AppEventObserverMgr::AppEventObserverMgr()
     RegisterAppStateCallback();
     moduleLoader_ = std::make_unique<ModuleLoader>();
     queue_ = std::make_shared<ffrt::queue>("AppEventQueue");
+    dispatcher_ = std::make_unique<AppEventDispatcher>([this](std::shared_ptr<AppEventObserver> observer) {
+        // the deadline of the periodic trigger is started only after the events are delivered
+        ScheduleTimeout(observer);
+    });
     SendRefreshFreeSizeTask();
 }
 
@@ -189,13 +202,15 @@ void AppEventObserverMgr::UnregisterAppStateCallback()
     HILOG_INFO(LOG_CORE, "succ to unregister application state callback");
 }
 
-void AppEventObserverMgr::SubmitTaskToFFRTQueue(std::function<void()>&& task, const std::string& taskName)
+bool AppEventObserverMgr::SubmitTaskToFFRTQueue(std::function<void()>&& task, const std::string& taskName,
+    uint64_t delayUs)
 {
     if (queue_ == nullptr) {
         HILOG_ERROR(LOG_CORE, "queue is null, failed to submit task=%{public}s", taskName.c_str());
-        return;
+        return false;
     }
-    queue_->submit(task, ffrt::task_attr().name(taskName.c_str()));
+    queue_->submit(task, ffrt::task_attr().name(taskName.c_str()).delay(delayUs));
+    return true;
 }
 
 int64_t AppEventObserverMgr::GetSeqFromWatchers(const std::string& name, std::string& filters)
@@ -225,13 +240,17 @@ void AppEventObserverMgr::DeleteWatcher(int64_t observerSeq)
 {
     std::unique_lock<std::shared_mutex> lock(watcherMutex_);
     watchers_.erase(observerSeq);
+    ++observersVersion_;
     UnregisterOsEventListener();
+    dispatcher_->RemoveObserver(observerSeq);
 }
 
 void AppEventObserverMgr::DeleteProcessor(int64_t observerSeq)
 {
     std::unique_lock<std::shared_mutex> lock(processorMutex_);
     processors_.erase(observerSeq);
+    ++observersVersion_;
+    dispatcher_->RemoveObserver(observerSeq);
 }
 
 bool AppEventObserverMgr::IsExistInWatchers(int64_t observerSeq)
@@ -264,6 +283,17 @@ std::vector<std::shared_ptr<AppEventObserver>> AppEventObserverMgr::GetObservers
     return observers;
 }
 
+std::shared_ptr<const AppEventRouter> AppEventObserverMgr::GetRouter()
+{
+    // the version is read before the observers, so a concurrent change leads to a rebuilding next time
+    uint64_t version = observersVersion_ + AppEventObserver::GetFiltersVersion();
+    std::lock_guard<std::mutex> lock(routerMutex_);
+    if (router_ == nullptr || router_->GetVersion() != version) {
+        router_ = std::make_shared<const AppEventRouter>(GetObservers(), version);
+    }
+    return router_;
+}
+
 void AppEventObserverMgr::InitWatchers()
 {
     static std::once_flag onceFlag;
@@ -278,8 +308,11 @@ void AppEventObserverMgr::InitWatchers()
             auto watcherPtr = std::make_shared<AppEventWatcher>(observer.name);
             watcherPtr->SetSeq(observer.seq);
             watcherPtr->SetFiltersStr(observer.filters);
+            SetEventFilterToDb(watcherPtr);
             watchers_[observer.seq] = watcherPtr;
+            dispatcher_->AddObserver(watcherPtr);
         }
+        ++observersVersion_;
         HILOG_INFO(LOG_CORE, "init watchers");
     });
 }
@@ -313,6 +346,8 @@ int64_t AppEventObserverMgr::AddWatcher(std::shared_ptr<AppEventWatcher> watcher
         return -1;
     }
     watchers_[observerSeq] = watcher;
+    ++observersVersion_;
+    dispatcher_->AddObserver(watcher);
     HILOG_INFO(LOG_CORE, "register watcher=%{public}" PRId64 " successfully", observerSeq);
     return observerSeq;
 }
@@ -383,6 +418,11 @@ int64_t AppEventObserverMgr::AddProcessor(const std::string& name, const ReportC
     processor->ProcessStartup();
     std::unique_lock<std::shared_mutex> lock(processorMutex_);
     processors_[observerSeq] = processor;
+    ++observersVersion_;
+    dispatcher_->AddObserver(processor);
+    lock.unlock();
+    // the pending events in the db are reported by the period as well
+    ScheduleTimeout(processor);
     HILOG_INFO(LOG_CORE, "register processor=%{public}" PRId64 " successfully", observerSeq);
     return observerSeq;
 }
@@ -430,6 +470,12 @@ int AppEventObserverMgr::RegisterProcessor(const std::string& name, std::shared_
     return moduleLoader_->RegisterProcessor(name, processor);
 }
 
+int AppEventObserverMgr::RegisterAsyncProcessor(const std::string& name,
+    std::shared_ptr<AppEventAsyncProcessor> processor)
+{
+    return moduleLoader_->RegisterProcessor(name, processor, processor);
+}
+
 int AppEventObserverMgr::UnregisterProcessor(const std::string& name)
 {
     return moduleLoader_->UnregisterProcessor(name);
@@ -438,51 +484,115 @@ int AppEventObserverMgr::UnregisterProcessor(const std::string& name)
 void AppEventObserverMgr::HandleEvents(std::vector<std::shared_ptr<AppEventPack>>& events)
 {
     InitWatchers();
-    auto observers = GetObservers();
+    auto router = GetRouter();
+    const auto& observers = router->GetObservers();
     if (observers.empty() || events.empty()) {
         return;
     }
     HILOG_DEBUG(LOG_CORE, "start to handle events size=%{public}zu", events.size());
-    StoreEventsToDb(events);
-    StoreEventMappingToDb(events, observers);
-    bool isNeedSend = false;
-    for (const auto& observer : observers) {
-        // send events to observer, and then delete events not in event mapping
-        SendEventsToObserver(events, observer);
-        isNeedSend |= observer->HasTimeoutCondition();
+    // route each event once, and group the events by observer
+    std::vector<std::vector<int64_t>> observerSeqs(events.size());
+    std::vector<std::vector<std::shared_ptr<AppEventPack>>> observerEvents(observers.size());
+    std::vector<size_t> indexes;
+    for (size_t i = 0; i < events.size(); ++i) {
+        router->Route(events[i], indexes);
+        for (auto index : indexes) {
+            observerSeqs[i].emplace_back(observers[index]->GetSeq());
+            observerEvents[index].emplace_back(events[i]);
+        }
     }
-    // timeout condition > 0 and the current event row > 0, send timeout task.
-    // There can be only one timeout task.
-    std::lock_guard<std::mutex> lock(isTimeoutTaskExistMutex_);
-    if (isNeedSend && !isTimeoutTaskExist_) {
-        SendTimeoutTask();
-        isTimeoutTaskExist_ = true;
+    StoreEventsToDb(events, observerSeqs);
+    // the events are delivered by the queue of each observer, so that a slow observer does not block the writing
+    for (size_t i = 0; i < observers.size(); ++i) {
+        dispatcher_->Dispatch(observers[i], std::move(observerEvents[i]));
     }
 }
 
-void AppEventObserverMgr::HandleTimeout()
+void AppEventObserverMgr::ScheduleTimeout(std::shared_ptr<AppEventObserver> observer)
 {
-    auto observers = GetObservers();
-    bool isNeedSend = false;
-    for (const auto& observer : observers) {
-        observer->ProcessTimeout();
-        isNeedSend |= observer->HasTimeoutCondition();
+    // the observer without the period or the pending events is not scheduled
+    int64_t deadline = observer->GetTimeoutDeadline(TimeUtil::GetElapsedMilliSecondsSinceBoot());
+    if (deadline <= 0) {
+        return;
     }
-    if (isNeedSend) {
-        SendTimeoutTask();
-    } else {
-        // when the current event row <= 0, do not send timeout task.
-        std::lock_guard<std::mutex> lock(isTimeoutTaskExistMutex_);
-        isTimeoutTaskExist_ = false;
+    int64_t observerSeq = observer->GetSeq();
+    {
+        std::lock_guard<std::mutex> lock(timeoutMutex_);
+        auto it = timeoutDeadlines_.find(observerSeq);
+        if (it != timeoutDeadlines_.end() && it->second == deadline) {
+            return;
+        }
+        // the task with the old deadline is left in the heap and skipped when it is due
+        timeoutDeadlines_[observerSeq] = deadline;
+        timeoutTasks_.push({deadline, observerSeq, observer});
     }
+    ArmTimeoutTimer();
 }
 
-void AppEventObserverMgr::SendTimeoutTask()
+void AppEventObserverMgr::ArmTimeoutTimer()
 {
     static auto TimeoutTimerCb = [](void*) {
         AppEventObserverMgr::GetInstance().HandleTimeout();
     };
-    timeoutTimer_.store(ffrt_timer_start(ffrt_qos_default, TIMEOUT_INTERVAL_MILLI, nullptr, TimeoutTimerCb, false));
+    ffrt_timer_t oldTimer = ffrt_error;
+    {
+        std::lock_guard<std::mutex> lock(timeoutMutex_);
+        if (timeoutTasks_.empty()) {
+            return;
+        }
+        int64_t deadline = timeoutTasks_.top().deadline;
+        if (timerDeadline_ > 0 && timerDeadline_ <= deadline) {
+            return;
+        }
+        int64_t delay = std::max<int64_t>(deadline - TimeUtil::GetElapsedMilliSecondsSinceBoot(), 0);
+        ffrt_timer_t timer = ffrt_timer_start(ffrt_qos_default, static_cast<uint64_t>(delay), nullptr,
+            TimeoutTimerCb, false);
+        if (timer == ffrt_error) {
+            HILOG_WARN(LOG_CORE, "failed to start timeout timer, delay=%{public}" PRId64, delay);
+            return;
+        }
+        // the armed timer has not expired yet if its deadline is not 0
+        oldTimer = timeoutTimer_.exchange(timer);
+        timerDeadline_ = deadline;
+    }
+    if (oldTimer != ffrt_error) {
+        ffrt_timer_stop(ffrt_qos_default, oldTimer);
+    }
+}
+
+std::vector<std::shared_ptr<AppEventObserver>> AppEventObserverMgr::TakeTimeoutObservers(int64_t now)
+{
+    std::vector<std::shared_ptr<AppEventObserver>> observers;
+    std::lock_guard<std::mutex> lock(timeoutMutex_);
+    if (timerDeadline_ > 0 && timerDeadline_ <= now) {
+        timerDeadline_ = 0;
+        timeoutTimer_.store(ffrt_error);
+    }
+    while (!timeoutTasks_.empty() && timeoutTasks_.top().deadline <= now) {
+        TimeoutTask task = timeoutTasks_.top();
+        timeoutTasks_.pop();
+        auto it = timeoutDeadlines_.find(task.observerSeq);
+        if (it == timeoutDeadlines_.end() || it->second != task.deadline) {
+            continue;
+        }
+        timeoutDeadlines_.erase(it);
+        if (auto observer = task.observer.lock(); observer != nullptr) {
+            observers.emplace_back(observer);
+        }
+    }
+    return observers;
+}
+
+void AppEventObserverMgr::HandleTimeout()
+{
+    // only the observers whose deadlines are reached are triggered
+    int64_t now = TimeUtil::GetElapsedMilliSecondsSinceBoot();
+    auto observers = TakeTimeoutObservers(now);
+    for (const auto& observer : observers) {
+        observer->ProcessTimeout(now);
+        ScheduleTimeout(observer);
+    }
+    ArmTimeoutTimer();
 }
 
 void AppEventObserverMgr::SendRefreshFreeSizeTask()
@@ -507,20 +617,39 @@ void AppEventObserverMgr::HandleBackground()
 void AppEventObserverMgr::HandleClearUp()
 {
     HILOG_INFO(LOG_CORE, "start to handle clear up");
+    dispatcher_->Clear();
     auto observers = GetObservers();
     for (const auto& observer : observers) {
         observer->ResetCurrCondition();
     }
+    // no events are pending after the clearing, so the timer is not needed
+    ffrt_timer_t oldTimer = ffrt_error;
+    {
+        std::lock_guard<std::mutex> lock(timeoutMutex_);
+        timeoutTasks_ = {};
+        timeoutDeadlines_.clear();
+        timerDeadline_ = 0;
+        oldTimer = timeoutTimer_.exchange(ffrt_error);
+    }
+    if (oldTimer != ffrt_error) {
+        ffrt_timer_stop(ffrt_qos_default, oldTimer);
+    }
 }
 
 int AppEventObserverMgr::SetReportConfig(int64_t observerSeq, const ReportConfig& config)
 {
-    std::unique_lock<std::shared_mutex> lock(processorMutex_);
-    if (processors_.find(observerSeq) == processors_.cend()) {
-        HILOG_WARN(LOG_CORE, "failed to set config, seq=%{public}" PRId64, observerSeq);
-        return -1;
+    std::shared_ptr<AppEventProcessorProxy> processor;
+    {
+        std::unique_lock<std::shared_mutex> lock(processorMutex_);
+        if (processors_.find(observerSeq) == processors_.cend()) {
+            HILOG_WARN(LOG_CORE, "failed to set config, seq=%{public}" PRId64, observerSeq);
+            return -1;
+        }
+        processor = processors_[observerSeq];
+        processor->SetReportConfig(config);
     }
-    processors_[observerSeq]->SetReportConfig(config);
+    // the deadline is started again by the new period
+    ScheduleTimeout(processor);
     return 0;
 }
 
@@ -535,6 +664,25 @@ int AppEventObserverMgr::GetReportConfig(int64_t observerSeq, ReportConfig& conf
     return 0;
 }
 
+int AppEventObserverMgr::SetDispatchConfig(int64_t observerSeq, const DispatchConfig& config)
+{
+    if (config.maxQueueSize == 0) {
+        HILOG_WARN(LOG_CORE, "failed to set dispatch config, the queue size is 0");
+        return -1;
+    }
+    if (!IsExistInWatchers(observerSeq) && !IsExistInProcessors(observerSeq)) {
+        HILOG_WARN(LOG_CORE, "failed to set dispatch config, seq=%{public}" PRId64, observerSeq);
+        return -1;
+    }
+    dispatcher_->SetConfig(observerSeq, config);
+    return 0;
+}
+
+int AppEventObserverMgr::GetDispatchStats(int64_t observerSeq, DispatchStats& stats)
+{
+    return dispatcher_->GetStats(observerSeq, stats) ? 0 : -1;
+}
+
 bool AppEventObserverMgr::InitWatcherFromListener(std::shared_ptr<AppEventWatcher> watcher, bool isExist)
 {
     uint64_t mask = watcher->GetOsEventsMask();
@@ -559,7 +707,13 @@ bool AppEventObserverMgr::InitWatcherFromListener(std::shared_ptr<AppEventWatche
                 curWatchers.emplace_back(it->second);
             }
             StoreEventMappingToDb(events, curWatchers);
-            SendEventsToObserver(events, watcher);  // send history events to current observer
+            std::vector<std::shared_ptr<AppEventPack>> watcherEvents;
+            for (const auto& event : events) {
+                if (watcher->VerifyEvent(event)) {
+                    watcherEvents.emplace_back(event);
+                }
+            }
+            SendEventsToObserver(watcherEvents, watcher);  // send history events to current observer
         }
     }
     return true;
@@ -15,9 +15,11 @@
 #include "app_event_processor_proxy.h"
 
 #include <algorithm>
+#include <atomic>
 #include <sstream>
 
 #include "app_event_store.h"
+#include "ffrt.h"
 #include "hiappevent_base.h"
 #include "hiappevent_userinfo.h"
 #include "hilog/log.h"
@@ -32,7 +34,12 @@ namespace OHOS {
 namespace HiviewDFX {
 namespace HiAppEvent {
 namespace {
-constexpr int MAX_SIZE_ON_EVENTS = 100;
+constexpr size_t MAX_SIZE_ON_EVENTS = 100;
+constexpr size_t MAX_IN_FLIGHT_BATCH_NUM = 4;
+constexpr uint32_t MAX_RETRY_TIMES = 6;
+constexpr uint64_t BASE_RETRY_DELAY_MS = 1000; // the backoff doubles from 1s after each failed report
+constexpr uint64_t US_PER_MS = 1000;
+constexpr const char* REPORT_TASK_NAME = "app_event_report";
 
 AppEventInfo CreateAppEventInfo(std::shared_ptr<AppEventPack> event)
 {
@@ -119,6 +126,33 @@ std::string TriggerCondition::ToString() const
     return strStream.str();
 }
 
+class AppEventProcessorProxy::ReportBatch : public ReportCompletion {
+public:
+    ReportBatch(std::weak_ptr<AppEventProcessorProxy> proxy, std::vector<int64_t>&& eventSeqs)
+        : proxy_(proxy), eventSeqs_(std::move(eventSeqs))
+    {}
+    ~ReportBatch() override
+    {
+        // a batch never completed by the processor is regarded as failed, so that its events can be reported again
+        Complete(-1);
+    }
+
+    void Complete(int result) override
+    {
+        if (isCompleted_.exchange(true)) {
+            return;
+        }
+        if (auto proxy = proxy_.lock(); proxy != nullptr) {
+            proxy->OnReportComplete(eventSeqs_, result);
+        }
+    }
+
+private:
+    std::weak_ptr<AppEventProcessorProxy> proxy_;
+    std::vector<int64_t> eventSeqs_;
+    std::atomic<bool> isCompleted_ = false;
+};
+
 std::string ReportConfig::ToString() const
 {
     std::stringstream strStream;
@@ -133,7 +167,15 @@ void AppEventProcessorProxy::OnEvents(const std::vector<std::shared_ptr<AppEvent
     if (events.empty()) {
         return;
     }
+    if (asyncProcessor_ != nullptr) {
+        ReportEventsAsync(events);
+        return;
+    }
+    ReportEvents(events);
+}
 
+void AppEventProcessorProxy::ReportEvents(const std::vector<std::shared_ptr<AppEventPack>>& events)
+{
     std::vector<UserId> userIds;
     GetValidUserIds(userIds);
     std::vector<UserProperty> userProperties;
@@ -151,11 +193,112 @@ void AppEventProcessorProxy::OnEvents(const std::vector<std::shared_ptr<AppEvent
                 observerSeq, eventSeqs.size());
         }
     } else {
+        // the events are kept in the db and reported by the next trigger
         HILOG_DEBUG(LOG_CORE, "failed to report event, seq=%{public}" PRId64 ", event num=%{public}zu",
             observerSeq, eventSeqs.size());
     }
 }
 
+void AppEventProcessorProxy::ReportEventsAsync(const std::vector<std::shared_ptr<AppEventPack>>& events)
+{
+    std::vector<AppEventInfo> eventInfos;
+    std::vector<int64_t> eventSeqs;
+    if (!AcquireReportBatch(events, eventInfos, eventSeqs)) {
+        return;
+    }
+    std::vector<UserId> userIds;
+    GetValidUserIds(userIds);
+    std::vector<UserProperty> userProperties;
+    GetValidUserProperties(userProperties);
+    auto completion = std::make_shared<ReportBatch>(weak_from_this(), std::move(eventSeqs));
+    asyncProcessor_->OnReportAsync(GetSeq(), userIds, userProperties, eventInfos, completion);
+}
+
+bool AppEventProcessorProxy::AcquireReportBatch(const std::vector<std::shared_ptr<AppEventPack>>& events,
+    std::vector<AppEventInfo>& eventInfos, std::vector<int64_t>& eventSeqs)
+{
+    std::lock_guard<std::mutex> lockGuard(reportMutex_);
+    if (inFlightBatchNum_ >= MAX_IN_FLIGHT_BATCH_NUM || std::chrono::steady_clock::now() < backoffEndTime_) {
+        // the events are kept in the db and reported after the in-flight report ends or the backoff ends
+        isReportPending_ = true;
+        return false;
+    }
+    for (const auto& event : events) {
+        if (inFlightSeqs_.find(event->GetSeq()) != inFlightSeqs_.end()) {
+            continue;
+        }
+        if (eventSeqs.size() >= MAX_SIZE_ON_EVENTS) {
+            // the rest events are reported after this report ends
+            isReportPending_ = true;
+            break;
+        }
+        eventInfos.emplace_back(CreateAppEventInfo(event));
+        eventSeqs.emplace_back(event->GetSeq());
+    }
+    if (eventSeqs.empty()) {
+        return false;
+    }
+    inFlightSeqs_.insert(eventSeqs.begin(), eventSeqs.end());
+    ++inFlightBatchNum_;
+    return true;
+}
+
+void AppEventProcessorProxy::OnReportComplete(const std::vector<int64_t>& eventSeqs, int result)
+{
+    int64_t observerSeq = GetSeq();
+    if (result == 0) {
+        if (!AppEventStore::GetInstance().DeleteData(observerSeq, eventSeqs)) {
+            HILOG_ERROR(LOG_CORE, "failed to delete mapping data, seq=%{public}" PRId64 ", event num=%{public}zu",
+                observerSeq, eventSeqs.size());
+        }
+    } else {
+        HILOG_DEBUG(LOG_CORE, "failed to report event, seq=%{public}" PRId64 ", event num=%{public}zu",
+            observerSeq, eventSeqs.size());
+    }
+
+    bool isNeedReport = false;
+    uint64_t delayMs = 0;
+    {
+        std::lock_guard<std::mutex> lockGuard(reportMutex_);
+        for (auto eventSeq : eventSeqs) {
+            inFlightSeqs_.erase(eventSeq);
+        }
+        --inFlightBatchNum_;
+        if (result == 0) {
+            retryTimes_ = 0;
+            backoffEndTime_ = {};
+            isNeedReport = isReportPending_;
+        } else {
+            retryTimes_ = std::min(retryTimes_ + 1, MAX_RETRY_TIMES);
+            delayMs = BASE_RETRY_DELAY_MS << (retryTimes_ - 1);
+            backoffEndTime_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(delayMs);
+            // stop retrying after the max times, then the events are reported by the next trigger
+            isNeedReport = !isRetryScheduled_ && retryTimes_ < MAX_RETRY_TIMES;
+            isRetryScheduled_ |= isNeedReport;
+        }
+        isReportPending_ = false;
+    }
+    if (isNeedReport) {
+        SendReportTask(delayMs);
+    }
+}
+
+void AppEventProcessorProxy::SendReportTask(uint64_t delayMs)
+{
+    std::weak_ptr<AppEventProcessorProxy> proxy = weak_from_this();
+    ffrt::submit([proxy] {
+        auto self = proxy.lock();
+        if (self == nullptr) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lockGuard(self->reportMutex_);
+            self->isRetryScheduled_ = false;
+        }
+        self->ReportEventsFromDb();
+        }, {}, {}, ffrt::task_attr().name(REPORT_TASK_NAME).delay(delayMs * US_PER_MS));
+}
+
 void AppEventProcessorProxy::GetValidUserIds(std::vector<UserId>& userIds)
 {
     int64_t userIdVerForAll = HiAppEvent::UserInfo::GetInstance().GetUserIdVersion();
@@ -196,10 +339,9 @@ void AppEventProcessorProxy::GetValidUserProperties(std::vector<UserProperty>& u
     userPropertyVersion_ = userPropertyVerForAll;
 }
 
-bool AppEventProcessorProxy::VerifyEvent(std::shared_ptr<AppEventPack> event)
+bool AppEventProcessorProxy::ValidateEvent(std::shared_ptr<AppEventPack> event)
 {
-    return AppEventObserver::VerifyEvent(event)
-        && (processor_->ValidateEvent(CreateAppEventInfo(event)) == 0);
+    return processor_->ValidateEvent(CreateAppEventInfo(event)) == 0;
 }
 
 bool AppEventProcessorProxy::IsRealTimeEvent(std::shared_ptr<AppEventPack> event)
@@ -263,6 +405,11 @@ int64_t AppEventProcessorProxy::GenerateHashCode()
 }
 
 void AppEventProcessorProxy::OnTrigger(const TriggerCondition& triggerCond)
+{
+    ReportEventsFromDb();
+}
+
+void AppEventProcessorProxy::ReportEventsFromDb()
 {
     std::vector<std::shared_ptr<AppEventPack>> events;
     QueryEventsFromDb(events);
@@ -275,7 +422,13 @@ void AppEventProcessorProxy::QueryEventsFromDb(std::vector<std::shared_ptr<AppEv
 {
     int64_t seq = GetSeq();
     std::string name = GetName();
-    if (AppEventStore::GetInstance().QueryEvents(events, seq, MAX_SIZE_ON_EVENTS) != 0) {
+    int row = static_cast<int>(MAX_SIZE_ON_EVENTS);
+    {
+        // the in-flight events are still in the db, query more events to skip them
+        std::lock_guard<std::mutex> lockGuard(reportMutex_);
+        row += static_cast<int>(inFlightSeqs_.size());
+    }
+    if (AppEventStore::GetInstance().QueryEvents(events, seq, row) != 0) {
         HILOG_WARN(LOG_CORE, "failed to take data from observer=%{public}s, seq=%{public}" PRId64,
             name.c_str(), seq);
         return;
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "app_event_router.h"
+
+#include <algorithm>
+
+#include "hiappevent_base.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr int MAX_EVENT_TYPE = 31;
+
+bool IsValidType(uint32_t types, int eventType)
+{
+    if (types == 0) {
+        return true;
+    }
+    return eventType >= 0 && eventType <= MAX_EVENT_TYPE && (types & (1U << eventType)) != 0;
+}
+}
+
+AppEventRouter::AppEventRouter(const std::vector<std::shared_ptr<AppEventObserver>>& observers, uint64_t version)
+    : version_(version), observers_(observers)
+{
+    for (size_t i = 0; i < observers_.size(); ++i) {
+        AddObserver(i, observers_[i]->GetFilters());
+    }
+}
+
+uint64_t AppEventRouter::GetVersion() const
+{
+    return version_;
+}
+
+const std::vector<std::shared_ptr<AppEventObserver>>& AppEventRouter::GetObservers() const
+{
+    return observers_;
+}
+
+void AppEventRouter::Route(std::shared_ptr<AppEventPack> event, std::vector<size_t>& indexes) const
+{
+    indexes = allEventsIndexes_;
+    uint32_t domainId = GetSymbolId(event->GetDomainSymbol());
+    if (auto domainIt = domains_.find(domainId); domainIt != domains_.end()) {
+        const auto& domainRoutes = domainIt->second;
+        MatchRoutes(domainRoutes.allNames, event->GetType(), indexes);
+        uint32_t nameId = GetSymbolId(event->GetNameSymbol());
+        if (auto nameIt = domainRoutes.names.find(nameId); nameIt != domainRoutes.names.end()) {
+            MatchRoutes(nameIt->second, event->GetType(), indexes);
+        }
+    }
+    // an observer may be matched by several filters
+    std::sort(indexes.begin(), indexes.end());
+    indexes.erase(std::unique(indexes.begin(), indexes.end()), indexes.end());
+    indexes.erase(std::remove_if(indexes.begin(), indexes.end(), [this, &event](size_t index) {
+        return !observers_[index]->ValidateEvent(event);
+    }), indexes.end());
+}
+
+void AppEventRouter::AddObserver(size_t index, const std::vector<HiAppEvent::AppEventFilter>& filters)
+{
+    if (filters.empty()) {
+        allEventsIndexes_.emplace_back(index);
+        return;
+    }
+    for (const auto& filter : filters) {
+        // the filter with empty domain matches no event
+        if (filter.domain.empty()) {
+            continue;
+        }
+        // the strings of the filters are always interned, so that the events are matched by the symbol ids
+        auto& domainRoutes = domains_[AppEventSymbol(filter.domain, true).GetId()];
+        if (filter.names.empty()) {
+            domainRoutes.allNames.push_back({index, filter.types});
+            continue;
+        }
+        for (const auto& name : filter.names) {
+            domainRoutes.names[AppEventSymbol(name, true).GetId()].push_back({index, filter.types});
+        }
+    }
+}
+
+uint32_t AppEventRouter::GetSymbolId(const AppEventSymbol& symbol)
+{
+    // the string of the event may be interned by the filters after the event is created
+    uint32_t id = symbol.GetId();
+    return id != AppEventSymbol::INVALID_ID ? id : AppEventSymbol::FindId(symbol.GetStr());
+}
+
+void AppEventRouter::MatchRoutes(const std::vector<RouteEntry>& routes, int eventType, std::vector<size_t>& indexes)
+{
+    for (const auto& route : routes) {
+        if (IsValidType(route.types, eventType)) {
+            indexes.emplace_back(route.index);
+        }
+    }
+}
+} // namespace HiviewDFX
+} // namespace OHOS
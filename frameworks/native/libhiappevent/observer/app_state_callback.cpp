@@ -15,10 +15,17 @@
 #include "app_state_callback.h"
 
 #include "app_event_observer_mgr.h"
+#include "time_util.h"
 
 namespace OHOS {
 namespace HiviewDFX {
 namespace HiAppEvent {
+void AppStateCallback::OnAbilityForeground(const AbilityRuntime::AbilityLifecycleCallbackArgs& ability)
+{
+    // the time zone may be changed while the app is in the background
+    TimeUtil::ClearLocalTimeCache();
+}
+
 void AppStateCallback::OnAbilityBackground(const AbilityRuntime::AbilityLifecycleCallbackArgs& ability)
 {
     AppEventObserverMgr::GetInstance().HandleBackground();
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_OBSERVER_APP_EVENT_DISPATCHER_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_OBSERVER_APP_EVENT_DISPATCHER_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "app_event_observer.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+using HiAppEvent::AppEventObserver;
+
+/*
+ * The policy applied to the events arriving when the queue is full. The real-time events can not be taken from
+ * the db later, so they are always queued and never dropped or spilled by the policy.
+ */
+enum class DispatchOverflowPolicy {
+    // discards the oldest non-real-time events waiting in the queue
+    DROP_OLDEST = 0,
+    // keeps only the number and size of the events, the events can still be taken from the db
+    SPILL_TO_DB = 1,
+};
+
+struct DispatchConfig {
+    /* The max number of the events waiting in the queue of an observer, exceeded only by the real-time events */
+    size_t maxQueueSize = 1000;
+
+    /* The policy applied to the events arriving when the queue is full */
+    DispatchOverflowPolicy overflowPolicy = DispatchOverflowPolicy::SPILL_TO_DB;
+};
+
+struct DispatchStats {
+    /* The number of the events waiting in the queue */
+    size_t queueDepth = 0;
+
+    /* The max number of the events that have waited in the queue */
+    size_t maxQueueDepth = 0;
+
+    /* The number of the events delivered to the observer */
+    uint64_t deliveredNum = 0;
+
+    /* The number of the events discarded by DispatchOverflowPolicy::DROP_OLDEST */
+    uint64_t droppedNum = 0;
+
+    /* The number of the events delivered only by their number and size */
+    uint64_t spilledNum = 0;
+};
+
+/*
+ * Delivers the events to each observer by its own bounded queue and serial worker,
+ * so that a slow observer does not delay the event writing and the other observers.
+ */
+class AppEventDispatcher : public NoCopyable {
+public:
+    using DeliveredCallback = std::function<void(std::shared_ptr<AppEventObserver>)>;
+
+    explicit AppEventDispatcher(DeliveredCallback callback = nullptr);
+    ~AppEventDispatcher() = default;
+    // the events are delivered only if the channel of the observer is created by AddObserver
+    void Dispatch(std::shared_ptr<AppEventObserver> observer, std::vector<std::shared_ptr<AppEventPack>>&& events);
+    void AddObserver(std::shared_ptr<AppEventObserver> observer);
+    void SetConfig(int64_t observerSeq, const DispatchConfig& config);
+    bool GetStats(int64_t observerSeq, DispatchStats& stats);
+    void RemoveObserver(int64_t observerSeq);
+    void Clear();
+
+    // waits until the events in all the queues are delivered, returns false if it is timeout
+    bool WaitIdle(uint64_t timeoutMs);
+
+    // delivers the events to the observer in the current thread
+    static void SendEvents(const std::vector<std::shared_ptr<AppEventPack>>& events,
+        std::shared_ptr<AppEventObserver> observer);
+
+private:
+    class Channel;
+
+private:
+    DeliveredCallback callback_;
+    std::mutex mutex_;
+    std::unordered_map<int64_t, std::shared_ptr<Channel>> channels_;
+    std::unordered_map<int64_t, DispatchConfig> configs_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_OBSERVER_APP_EVENT_DISPATCHER_H
@@ -59,13 +59,19 @@ public:
     virtual ~AppEventObserver() = default;
     virtual void OnEvents(const std::vector<std::shared_ptr<AppEventPack>>& events) {}
     virtual bool VerifyEvent(std::shared_ptr<AppEventPack> event);
+    // checks the event matched by the filters, e.g. by the plugin of the processor
+    virtual bool ValidateEvent(std::shared_ptr<AppEventPack> event) { return true; }
     virtual bool IsRealTimeEvent(std::shared_ptr<AppEventPack> event) { return false; }
     virtual void OnTrigger(const TriggerCondition& triggerCond) {}
     void ProcessEvent(std::shared_ptr<AppEventPack> event);
-    void ProcessTimeout();
+    // processes the events only by their number and size, e.g. the events spilled by the dispatcher
+    void ProcessEvents(int row, int size);
+    // triggers the observer if the deadline of the periodic trigger is reached at the time in milliseconds
+    void ProcessTimeout(int64_t now);
     void ProcessStartup();
     void ProcessBackground();
-    bool HasTimeoutCondition();
+    // returns the deadline of the periodic trigger in milliseconds since boot, 0 means no pending events to trigger
+    int64_t GetTimeoutDeadline(int64_t now);
 
     std::string GetName();
     int64_t GetSeq();
@@ -77,6 +83,11 @@ public:
     std::vector<AppEventFilter> GetFilters();
     void SetFilters(const std::vector<AppEventFilter>& filters);
     void AddFilter(const AppEventFilter& filter);
+    // increased each time the filters of any observer are changed
+    static uint64_t GetFiltersVersion();
+
+private:
+    void ClearCurrCondition();
 
 private:
     std::string name_;
@@ -84,6 +95,7 @@ private:
     std::vector<AppEventFilter> filters_;
     TriggerCondition triggerCond_;
     TriggerCondition currCond_;
+    int64_t timeoutDeadline_ = 0; // started by the first pending event, in milliseconds since boot
     std::mutex mutex_;
     std::mutex condMutex_;
 };
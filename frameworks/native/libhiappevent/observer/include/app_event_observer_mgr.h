@@ -16,13 +16,18 @@
 #define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_OBSERVER_APP_EVENT_OBSERVER_MGR_H
 
 #include <atomic>
+#include <functional>
 #include <memory>
+#include <queue>
 #include <shared_mutex>
 #include <unordered_map>
+#include <vector>
 
+#include "app_event_dispatcher.h"
 #include "app_event_observer.h"
 #include "app_event_processor.h"
 #include "app_event_processor_proxy.h"
+#include "app_event_router.h"
 #include "app_event_watcher.h"
 #include "ffrt.h"
 #include "module_loader.h"
@@ -52,6 +57,7 @@ public:
     int RemoveObserver(const std::string& observerName);
     int Load(const std::string& moduleName);
     int RegisterProcessor(const std::string& name, std::shared_ptr<AppEventProcessor> processor);
+    int RegisterAsyncProcessor(const std::string& name, std::shared_ptr<AppEventAsyncProcessor> processor);
     int UnregisterProcessor(const std::string& name);
     void HandleEvents(std::vector<std::shared_ptr<AppEventPack>>& events);
     void HandleTimeout();
@@ -59,14 +65,19 @@ public:
     void HandleClearUp();
     int SetReportConfig(int64_t observerSeq, const ReportConfig& config);
     int GetReportConfig(int64_t observerSeq, ReportConfig& config);
-    void SubmitTaskToFFRTQueue(std::function<void()>&& task, const std::string& taskName);
+    int SetDispatchConfig(int64_t observerSeq, const DispatchConfig& config);
+    int GetDispatchStats(int64_t observerSeq, DispatchStats& stats);
+    // returns false if the task is not submitted
+    bool SubmitTaskToFFRTQueue(std::function<void()>&& task, const std::string& taskName, uint64_t delayUs = 0);
 
 private:
     AppEventObserverMgr();
     ~AppEventObserverMgr();
     int64_t AddProcessorWithTimeLimited(const std::string& name, int64_t hashCode,
         std::shared_ptr<AppEventProcessorProxy> processor);
-    void SendTimeoutTask();
+    void ScheduleTimeout(std::shared_ptr<AppEventObserver> observer);
+    void ArmTimeoutTimer();
+    std::vector<std::shared_ptr<AppEventObserver>> TakeTimeoutObservers(int64_t now);
     void SendRefreshFreeSizeTask();
     void RegisterAppStateCallback();
     void UnregisterAppStateCallback();
@@ -77,26 +88,49 @@ private:
     int64_t GetSeqFromWatchers(const std::string& name, std::string& filters);
     int64_t GetSeqFromProcessors(const std::string& name, int64_t hashCode);
     std::vector<std::shared_ptr<AppEventObserver>> GetObservers();
+    std::shared_ptr<const AppEventRouter> GetRouter();
     void DeleteWatcher(int64_t observerSeq);
     void DeleteProcessor(int64_t observerSeq);
     bool IsExistInWatchers(int64_t observerSeq);
     bool IsExistInProcessors(int64_t observerSeq);
 
 private:
+    struct TimeoutTask {
+        /* The deadline of the periodic trigger in milliseconds since boot */
+        int64_t deadline = 0;
+
+        /* The sequence of the observer to be triggered */
+        int64_t observerSeq = 0;
+
+        std::weak_ptr<AppEventObserver> observer;
+
+        bool operator>(const TimeoutTask& other) const
+        {
+            return deadline > other.deadline;
+        }
+    };
+
     std::unique_ptr<ModuleLoader> moduleLoader_; // moduleLoader_ must declared before observers_, or lead to crash
     std::unordered_map<int64_t, std::shared_ptr<AppEventWatcher>> watchers_;
     std::unordered_map<int64_t, std::shared_ptr<AppEventProcessorProxy>> processors_;
     std::shared_mutex watcherMutex_;
     std::shared_mutex processorMutex_;
+    std::shared_ptr<const AppEventRouter> router_;
+    std::mutex routerMutex_;
+    std::atomic<uint64_t> observersVersion_ = 0;
     std::shared_ptr<ffrt::queue> queue_ = nullptr;
+    std::unique_ptr<AppEventDispatcher> dispatcher_;
     std::shared_ptr<AppStateCallback> appStateCallback_;
     std::shared_ptr<OsEventListener> listener_ = nullptr;
-    bool isTimeoutTaskExist_ = false;
-    std::mutex isTimeoutTaskExistMutex_;
     std::atomic<bool> isFirstAddProcessor_ = true;
     std::atomic<bool> isDbInit_ = false;
     std::atomic<ffrt_timer_t> refreshTimer_ = ffrt_error;
     std::atomic<ffrt_timer_t> timeoutTimer_ = ffrt_error;
+    // the observers with the pending events are ordered by their deadlines, only one timer is armed for the earliest
+    std::priority_queue<TimeoutTask, std::vector<TimeoutTask>, std::greater<TimeoutTask>> timeoutTasks_;
+    std::unordered_map<int64_t, int64_t> timeoutDeadlines_; // the deadline of the valid task of each observer
+    int64_t timerDeadline_ = 0; // the deadline of the armed timer, 0 means that no timer is armed
+    std::mutex timeoutMutex_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -15,7 +15,9 @@
 #ifndef HIAPPEVENT_INTERFACES_NATIVE_INNER_API_INCLUDE_APP_EVENT_PROCESSOR_PROXY_H
 #define HIAPPEVENT_INTERFACES_NATIVE_INNER_API_INCLUDE_APP_EVENT_PROCESSOR_PROXY_H
 
+#include <chrono>
 #include <string>
+#include <unordered_set>
 
 #include "app_event_observer.h"
 #include "app_event_processor.h"
@@ -25,12 +27,14 @@ namespace HiviewDFX {
 namespace HiAppEvent {
 class AppEventProcessorProxy : public AppEventObserver, public std::enable_shared_from_this<AppEventProcessorProxy> {
 public:
-    AppEventProcessorProxy(const std::string& name, std::shared_ptr<AppEventProcessor> processor)
-        : AppEventObserver(name), processor_(processor), userIdVersion_(-1), userPropertyVersion_(-1) {}
+    AppEventProcessorProxy(const std::string& name, std::shared_ptr<AppEventProcessor> processor,
+        std::shared_ptr<AppEventAsyncProcessor> asyncProcessor = nullptr)
+        : AppEventObserver(name), processor_(processor), asyncProcessor_(asyncProcessor), userIdVersion_(-1),
+        userPropertyVersion_(-1) {}
     ~AppEventProcessorProxy() = default;
 
     void OnEvents(const std::vector<std::shared_ptr<AppEventPack>>& events) override;
-    bool VerifyEvent(std::shared_ptr<AppEventPack> event) override;
+    bool ValidateEvent(std::shared_ptr<AppEventPack> event) override;
     bool IsRealTimeEvent(std::shared_ptr<AppEventPack> event) override;
     void OnTrigger(const TriggerCondition& triggerCond) override;
     ReportConfig GetReportConfig();
@@ -42,9 +46,20 @@ private:
     void GetValidUserIds(std::vector<UserId>& userIds);
     void GetValidUserProperties(std::vector<UserProperty>& userProperties);
     void QueryEventsFromDb(std::vector<std::shared_ptr<AppEventPack>>& events);
+    void ReportEventsFromDb();
+    void ReportEvents(const std::vector<std::shared_ptr<AppEventPack>>& events);
+    void ReportEventsAsync(const std::vector<std::shared_ptr<AppEventPack>>& events);
+    bool AcquireReportBatch(const std::vector<std::shared_ptr<AppEventPack>>& events,
+        std::vector<AppEventInfo>& eventInfos, std::vector<int64_t>& eventSeqs);
+    void OnReportComplete(const std::vector<int64_t>& eventSeqs, int result);
+    void SendReportTask(uint64_t delayMs);
+
+    class ReportBatch;
 
 private:
     std::shared_ptr<AppEventProcessor> processor_;
+    /* Not null if the events are reported asynchronously, the states of the reports below are only for it */
+    std::shared_ptr<AppEventAsyncProcessor> asyncProcessor_;
     int64_t userIdVersion_;
     int64_t userPropertyVersion_;
     std::vector<UserId> userIds_;
@@ -52,6 +67,21 @@ private:
     ReportConfig reportConfig_;
     int64_t hashCode_ = 0;
     std::mutex mutex_;
+
+    // guards the states of the reports below
+    std::mutex reportMutex_;
+    /* The seqs of the events being reported, which are not reported again until the report ends */
+    std::unordered_set<int64_t> inFlightSeqs_;
+    /* The number of the reports which are not ended */
+    size_t inFlightBatchNum_ = 0;
+    /* Whether a report is deferred by the concurrency limit or the backoff */
+    bool isReportPending_ = false;
+    /* Whether a retrying task is submitted and not executed yet */
+    bool isRetryScheduled_ = false;
+    /* The number of the continuous failed reports */
+    uint32_t retryTimes_ = 0;
+    /* The reports are deferred until the time after a failed report */
+    std::chrono::steady_clock::time_point backoffEndTime_;
 };
 } // namespace HiAppEvent
 } // namespace HiviewDFX
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_OBSERVER_APP_EVENT_ROUTER_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_OBSERVER_APP_EVENT_ROUTER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "app_event_observer.h"
+#include "hiappevent_base.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+using HiAppEvent::AppEventObserver;
+
+/*
+ * The routing index compiled from the filters of the observers, which is immutable after it is built.
+ * It is rebuilt when the observers or their filters are changed.
+ */
+class AppEventRouter {
+public:
+    AppEventRouter(const std::vector<std::shared_ptr<AppEventObserver>>& observers, uint64_t version);
+    ~AppEventRouter() = default;
+    uint64_t GetVersion() const;
+    const std::vector<std::shared_ptr<AppEventObserver>>& GetObservers() const;
+
+    // gets the indexes of the observers that the event is sent to, in the order of the observers
+    void Route(std::shared_ptr<AppEventPack> event, std::vector<size_t>& indexes) const;
+
+private:
+    struct RouteEntry {
+        /* The index of the observer */
+        size_t index = 0;
+
+        /* The event types of the filter, stored in bits, 0 means all types */
+        uint32_t types = 0;
+    };
+
+    struct DomainRoutes {
+        /* The routes of the filters without event names */
+        std::vector<RouteEntry> allNames;
+
+        /* The routes of the filters with event names, grouped by the symbol id of event name */
+        std::unordered_map<uint32_t, std::vector<RouteEntry>> names;
+    };
+
+    void AddObserver(size_t index, const std::vector<HiAppEvent::AppEventFilter>& filters);
+    static uint32_t GetSymbolId(const AppEventSymbol& symbol);
+    static void MatchRoutes(const std::vector<RouteEntry>& routes, int eventType, std::vector<size_t>& indexes);
+
+private:
+    uint64_t version_ = 0;
+    std::vector<std::shared_ptr<AppEventObserver>> observers_;
+    std::vector<size_t> allEventsIndexes_; // the observers without filters receive all events
+    std::unordered_map<uint32_t, DomainRoutes> domains_; // grouped by the symbol id of domain
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_OBSERVER_APP_EVENT_ROUTER_H
@@ -41,7 +41,7 @@ public:
 
     void OnAbilityDestroy(const AbilityRuntime::AbilityLifecycleCallbackArgs& ability) override {}
 
-    void OnAbilityForeground(const AbilityRuntime::AbilityLifecycleCallbackArgs& ability) override {}
+    void OnAbilityForeground(const AbilityRuntime::AbilityLifecycleCallbackArgs& ability) override;
 
     void OnAbilityBackground(const AbilityRuntime::AbilityLifecycleCallbackArgs& ability) override;
 
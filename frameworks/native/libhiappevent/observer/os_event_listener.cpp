@@ -107,14 +107,12 @@ void OsEventListener::Init()
     std::vector<std::string> files;
     FileUtil::GetDirFiles(osEventPath_, files);
     GetEventsFromFiles(files, historyEvents_);
-    for (auto& event : historyEvents_) {
-        int64_t eventSeq = AppEventStore::GetInstance().InsertEvent(event);
-        if (eventSeq <= 0) {
-            HILOG_WARN(LOG_CORE, "failed to store event to db");
-            continue;
+    if (AppEventStore::GetInstance().InsertEvents(historyEvents_) == AppEventCacheCommon::DB_SUCC) {
+        for (auto& event : historyEvents_) {
+            AppEventStore::GetInstance().QueryCustomParamsAdd2EventPack(event);
         }
-        event->SetSeq(eventSeq);
-        AppEventStore::GetInstance().QueryCustomParamsAdd2EventPack(event);
+    } else {
+        HILOG_WARN(LOG_CORE, "failed to store events to db, size=%{public}zu", historyEvents_.size());
     }
     for (const auto& file : files) {
         (void)FileUtil::RemoveFile(file);
@@ -17,8 +17,6 @@
 #include "hilog/log.h"
 #include "time_util.h"
 
-#include <limits>
-
 #undef LOG_DOMAIN
 #define LOG_DOMAIN 0xD002D07
 
@@ -29,18 +27,35 @@ namespace OHOS {
 namespace HiviewDFX {
 namespace HiAppEvent {
 
-void ApiStatsAggregator::Record(ApiDescriptor descriptor, ApiMetric metric)
+void ApiStatsAggregator::Record(const ApiDescriptor& descriptor, const ApiMetric& metric)
 {
     HILOG_DEBUG(LOG_CORE, "Record: kitName=%{public}s, apiName=%{public}s",
         descriptor.KitName().c_str(), descriptor.ApiName().c_str());
-    apiMetricsMap_[descriptor].emplace_back(metric);
+    apiStatsMap_[descriptor].Merge(metric);
+    MarkAsUpdated();
+}
+
+void ApiStatsAggregator::Record(std::string_view kitName, std::string_view apiName, const ApiMetric& metric)
+{
+    apiStatsMap_.Get(kitName, apiName).Merge(metric);
+    MarkAsUpdated();
+}
+
+void ApiStatsAggregator::Merge(const ApiStatsMap& apiStats)
+{
+    if (apiStats.empty()) {
+        return;
+    }
+    for (const auto& [descriptor, stats] : apiStats) {
+        apiStatsMap_[descriptor].Merge(stats);
+    }
     MarkAsUpdated();
 }
 
 void ApiStatsAggregator::ClearRecord()
 {
     HILOG_DEBUG(LOG_CORE, "ClearRecord");
-    apiMetricsMap_.clear();
+    apiStatsMap_.clear();
     MarkAsBackuped();
 }
 
@@ -59,20 +74,28 @@ bool ApiStatsAggregator::IsUpdatedAfterLastBackup()
     return updatedAfterLastBackup_;
 }
 
-ApiMetricsMap ApiStatsAggregator::GetApiMetrics() const
+ApiStatsMap ApiStatsAggregator::GetApiStats() const
+{
+    return apiStatsMap_;
+}
+
+ApiStatsMap ApiStatsAggregator::TakeApiStats()
 {
-    return apiMetricsMap_;
+    ApiStatsMap apiStats;
+    apiStats.swap(apiStatsMap_);
+    MarkAsBackuped();
+    return apiStats;
 }
 
-std::vector<ApiStatsReport> ApiStatsAggregator::AggregateStats(const ApiMetricsMap& apiMetrics)
+std::vector<ApiStatsReport> ApiStatsAggregator::AggregateStats(const ApiStatsMap& apiStats)
 {
-    HILOG_DEBUG(LOG_CORE, "AggregateStats: input count=%{public}zu", apiMetrics.size());
+    HILOG_DEBUG(LOG_CORE, "AggregateStats: input count=%{public}zu", apiStats.size());
     static int64_t SIXTY_SECONDS_MS = 60 * 1000;
     int64_t beginTime = TimeUtil::GetMilliSecondsTimestamp(CLOCK_REALTIME) - SIXTY_SECONDS_MS;
     std::vector<ApiStatsReport> reports;
     
-    for (const auto& [descriptor, metrics] : apiMetrics) {
-        if (metrics.empty()) {
+    for (const auto& [descriptor, stats] : apiStats) {
+        if (stats.callTimes <= 0) {
             continue;
         }
         
@@ -80,28 +103,13 @@ std::vector<ApiStatsReport> ApiStatsAggregator::AggregateStats(const ApiMetricsM
         report.kitName = descriptor.KitName();
         report.apiName = descriptor.ApiName();
         report.beginTime = beginTime;
-        report.callTimes = static_cast<int>(metrics.size());
-        report.successTimes = 0;
-        report.maxCostTime = 0;
-        report.minCostTime = std::numeric_limits<int64_t>::max();
-        report.totalCostTime = 0;
-        std::map<int, int> errorCodeMap;
-        
-        for (const auto& metric : metrics) {
-            if (metric.successful) {
-                report.successTimes++;
-            }
-            report.totalCostTime += metric.duration;
-            if (metric.duration > report.maxCostTime) {
-                report.maxCostTime = metric.duration;
-            }
-            if (metric.duration < report.minCostTime) {
-                report.minCostTime = metric.duration;
-            }
-            errorCodeMap[metric.errCode]++;
-        }
+        report.callTimes = stats.callTimes;
+        report.successTimes = stats.successTimes;
+        report.maxCostTime = stats.maxCostTime;
+        report.minCostTime = stats.minCostTime;
+        report.totalCostTime = stats.totalCostTime;
         
-        for (const auto& [errCode, count] : errorCodeMap) {
+        for (const auto& [errCode, count] : stats.errorCodeNum) {
             report.errorCodeTypes.push_back(std::to_string(errCode));
             report.errorCodeNum.push_back(count);
         }
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "api_stats_map.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace HiAppEvent {
+ApiStats& ApiStatsMap::operator[](const ApiDescriptor& descriptor)
+{
+    return GetOrInsert(descriptor.KitName(), descriptor.ApiName(), descriptor.Hash());
+}
+
+ApiStats& ApiStatsMap::Get(std::string_view kitName, std::string_view apiName)
+{
+    return GetOrInsert(kitName, apiName, ApiDescriptor::HashOf(kitName, apiName));
+}
+
+ApiStatsMap::iterator ApiStatsMap::find(const ApiDescriptor& descriptor)
+{
+    if (entries_.empty()) {
+        return entries_.end();
+    }
+    uint32_t slot = slots_[FindSlot(descriptor.KitName(), descriptor.ApiName(), descriptor.Hash())];
+    return slot == EMPTY_SLOT ? entries_.end() : entries_.begin() + (slot - 1);
+}
+
+ApiStatsMap::const_iterator ApiStatsMap::find(const ApiDescriptor& descriptor) const
+{
+    if (entries_.empty()) {
+        return entries_.end();
+    }
+    uint32_t slot = slots_[FindSlot(descriptor.KitName(), descriptor.ApiName(), descriptor.Hash())];
+    return slot == EMPTY_SLOT ? entries_.end() : entries_.begin() + (slot - 1);
+}
+
+void ApiStatsMap::clear()
+{
+    entries_.clear();
+    slots_.clear();
+}
+
+void ApiStatsMap::swap(ApiStatsMap& other)
+{
+    entries_.swap(other.entries_);
+    slots_.swap(other.slots_);
+}
+
+ApiStats& ApiStatsMap::GetOrInsert(std::string_view kitName, std::string_view apiName, size_t hash)
+{
+    // the load factor is kept at most 1/2, so the probing ends soon
+    if ((entries_.size() + 1) * 2 > slots_.size()) {
+        Rehash(slots_.empty() ? MIN_CAPACITY : slots_.size() * 2);
+    }
+    size_t index = FindSlot(kitName, apiName, hash);
+    if (slots_[index] != EMPTY_SLOT) {
+        return entries_[slots_[index] - 1].second;
+    }
+    entries_.emplace_back(ApiDescriptor(kitName, apiName), ApiStats());
+    slots_[index] = static_cast<uint32_t>(entries_.size());
+    return entries_.back().second;
+}
+
+size_t ApiStatsMap::FindSlot(std::string_view kitName, std::string_view apiName, size_t hash) const
+{
+    // the capacity is the power of 2
+    size_t mask = slots_.size() - 1;
+    for (size_t index = hash & mask;; index = (index + 1) & mask) {
+        uint32_t slot = slots_[index];
+        if (slot == EMPTY_SLOT) {
+            return index;
+        }
+        const auto& descriptor = entries_[slot - 1].first;
+        if (descriptor.Hash() == hash && descriptor.Equals(kitName, apiName)) {
+            return index;
+        }
+    }
+}
+
+void ApiStatsMap::Rehash(size_t capacity)
+{
+    slots_.assign(capacity, EMPTY_SLOT);
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        size_t index = entries_[i].first.Hash() & mask;
+        while (slots_[index] != EMPTY_SLOT) {
+            index = (index + 1) & mask;
+        }
+        slots_[index] = static_cast<uint32_t>(i + 1);
+    }
+}
+} // namespace HiAppEvent
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -15,6 +15,7 @@
 
 #include "api_stats_mgr.h"
 
+#include <atomic>
 #include <cinttypes>
 
 #include "hiappevent_base.h"
@@ -48,24 +49,47 @@ ApiStatsManager::~ApiStatsManager()
     timer_.Stop();
 }
 
-void ApiStatsManager::AddRecord(ApiDescriptor descriptor, ApiMetric metric)
+void ApiStatsManager::AddRecord(std::string_view kitName, std::string_view apiName, const ApiMetric& metric)
 {
-    HILOG_DEBUG(LOG_CORE, "AddRecord: kitName=%{public}s, apiName=%{public}s",
-        descriptor.KitName().c_str(), descriptor.ApiName().c_str());
-    std::lock_guard<std::mutex> lock(mut_);
-    aggregator_.Record(descriptor, metric);
+    auto& shard = GetShard();
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.aggregator.Record(kitName, apiName, metric);
+}
+
+ApiStatsManager::Shard& ApiStatsManager::GetShard()
+{
+    static std::atomic<size_t> threadNum {0};
+    // the threads are assigned to the shards in turn when they record for the first time
+    thread_local size_t shardIndex = threadNum.fetch_add(1, std::memory_order_relaxed) % SHARD_NUM;
+    return shards_[shardIndex];
+}
+
+void ApiStatsManager::CollectShards()
+{
+    for (auto& shard : shards_) {
+        ApiStatsMap apiStats;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (!shard.aggregator.IsUpdatedAfterLastBackup()) {
+                continue;
+            }
+            apiStats = shard.aggregator.TakeApiStats();
+        }
+        aggregator_.Merge(apiStats);
+    }
 }
 
 void ApiStatsManager::ScheduleBackUpInner()
 {
+    CollectShards();
     if (!aggregator_.IsUpdatedAfterLastBackup()) {
         HILOG_INFO(LOG_CORE, "ScheduleBackUpInner: no update, skip");
         return;
     }
 
-    auto apiMetrics = aggregator_.GetApiMetrics();
-    HILOG_INFO(LOG_CORE, "ScheduleBackUpInner: backup count=%{public}zu", apiMetrics.size());
-    if (ApiStatsStorage::GetInstance().Backup(apiMetrics) == 0) {
+    auto apiStats = aggregator_.GetApiStats();
+    HILOG_INFO(LOG_CORE, "ScheduleBackUpInner: backup count=%{public}zu", apiStats.size());
+    if (ApiStatsStorage::GetInstance().Backup(apiStats) == 0) {
         aggregator_.ClearRecord();
         HILOG_DEBUG(LOG_CORE, "ScheduleBackUpInner success");
     } else {
@@ -86,22 +110,16 @@ void ApiStatsManager::ScheduleReport()
     std::lock_guard<std::mutex> lock(mut_);
     ApiStatsManager::ScheduleBackUpInner();
     
-    ApiMetricsMap apiMetrics;
-    if (ApiStatsStorage::GetInstance().QueryAll(apiMetrics) != 0) {
-        HILOG_ERROR(LOG_CORE, "failed to query api stats for report");
+    ApiStatsMap apiStats;
+    if (ApiStatsStorage::GetInstance().TakeAll(apiStats) != 0) {
+        HILOG_ERROR(LOG_CORE, "failed to take api stats for report");
         return;
     }
     
-    HILOG_DEBUG(LOG_CORE, "ScheduleReport: query count=%{public}zu", apiMetrics.size());
-    auto reports = ApiStatsAggregator::AggregateStats(apiMetrics);
+    HILOG_DEBUG(LOG_CORE, "ScheduleReport: take count=%{public}zu", apiStats.size());
+    auto reports = ApiStatsAggregator::AggregateStats(apiStats);
     
     ReportStats(reports);
-    
-    if (ApiStatsStorage::GetInstance().Clear() != 0) {
-        HILOG_ERROR(LOG_CORE, "failed to clear api stats after report");
-    } else {
-        HILOG_DEBUG(LOG_CORE, "ScheduleReport: clear success");
-    }
 }
 
 std::shared_ptr<AppEventPack> ApiStatsManager::ConvertReportToEventPack(const ApiStatsReport& report)
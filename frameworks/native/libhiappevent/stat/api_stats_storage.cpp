@@ -15,11 +15,12 @@
 
 #include "api_stats_storage.h"
 
-#include <unordered_map>
+#include <charconv>
+#include <limits>
+#include <string_view>
 
 #include "app_event_store.h"
 #include "hilog/log.h"
-#include "json/json.h"
 #include "rdb_errno.h"
 
 #undef LOG_DOMAIN
@@ -34,6 +35,90 @@ namespace HiAppEvent {
 namespace {
 constexpr int DB_FAILED = -1;
 constexpr int DB_SUCC = 0;
+constexpr char ERROR_CODE_SEPARATOR = ',';
+constexpr char ERROR_NUM_SEPARATOR = ':';
+
+// encodes the number of the calls of each error code as "code:num,code:num"
+std::string EncodeErrorCodes(const std::map<int, int>& errorCodeNum)
+{
+    std::string errorCodes;
+    for (const auto& [errCode, num] : errorCodeNum) {
+        if (!errorCodes.empty()) {
+            errorCodes += ERROR_CODE_SEPARATOR;
+        }
+        errorCodes.append(std::to_string(errCode)).append(1, ERROR_NUM_SEPARATOR).append(std::to_string(num));
+    }
+    return errorCodes;
+}
+
+bool ParseInt(std::string_view str, int& value)
+{
+    auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+    return ec == std::errc() && ptr == str.data() + str.size();
+}
+
+// the encoded error codes of the records of an api are concatenated by the db, so an error code may appear repeatedly
+bool DecodeErrorCodes(std::string_view errorCodes, std::map<int, int>& errorCodeNum)
+{
+    while (!errorCodes.empty()) {
+        size_t end = errorCodes.find(ERROR_CODE_SEPARATOR);
+        std::string_view item = errorCodes.substr(0, end);
+        errorCodes = (end == std::string_view::npos) ? std::string_view() : errorCodes.substr(end + 1);
+
+        size_t pos = item.find(ERROR_NUM_SEPARATOR);
+        int errCode = 0;
+        int num = 0;
+        if (pos == std::string_view::npos || !ParseInt(item.substr(0, pos), errCode)
+            || !ParseInt(item.substr(pos + 1), num) || num <= 0) {
+            return false;
+        }
+        errorCodeNum[errCode] += num;
+    }
+    return true;
+}
+
+AppEventCacheCommon::ApiStatsRecord ToRecord(const ApiDescriptor& descriptor, const ApiStats& stats)
+{
+    AppEventCacheCommon::ApiStatsRecord record;
+    record.kitName = descriptor.KitName();
+    record.apiName = descriptor.ApiName();
+    record.callTimes = stats.callTimes;
+    record.successTimes = stats.successTimes;
+    record.maxCostTime = stats.maxCostTime;
+    record.minCostTime = stats.minCostTime;
+    record.totalCostTime = stats.totalCostTime;
+    record.errorCodes = EncodeErrorCodes(stats.errorCodeNum);
+    return record;
+}
+
+bool ToStats(const AppEventCacheCommon::ApiStatsRecord& record, ApiStats& stats)
+{
+    if (record.callTimes <= 0 || record.callTimes > std::numeric_limits<int>::max() || record.successTimes < 0
+        || record.successTimes > record.callTimes || record.minCostTime < 0
+        || record.minCostTime > record.maxCostTime || record.totalCostTime < 0) {
+        return false;
+    }
+    stats.callTimes = static_cast<int>(record.callTimes);
+    stats.successTimes = static_cast<int>(record.successTimes);
+    stats.maxCostTime = record.maxCostTime;
+    stats.minCostTime = record.minCostTime;
+    stats.totalCostTime = record.totalCostTime;
+    return DecodeErrorCodes(record.errorCodes, stats.errorCodeNum);
+}
+
+void ToApiStatsMap(const std::vector<AppEventCacheCommon::ApiStatsRecord>& records, ApiStatsMap& apiStats)
+{
+    apiStats.clear();
+    for (const auto& record : records) {
+        ApiStats stats;
+        if (!ToStats(record, stats)) {
+            HILOG_WARN(LOG_CORE, "invalid api stats, kitName=%{public}s, apiName=%{public}s",
+                record.kitName.c_str(), record.apiName.c_str());
+            continue;
+        }
+        apiStats.Get(record.kitName, record.apiName) = std::move(stats);
+    }
+}
 }
 
 ApiStatsStorage::ApiStatsStorage()
@@ -50,98 +135,59 @@ ApiStatsStorage& ApiStatsStorage::GetInstance()
     return instance;
 }
 
-int ApiStatsStorage::Backup(const ApiMetricsMap& apiMetrics)
+int ApiStatsStorage::Backup(const ApiStatsMap& apiStats)
 {
-    HILOG_DEBUG(LOG_CORE, "Backup start: input count=%{public}zu", apiMetrics.size());
-    if (apiMetrics.empty()) {
-        HILOG_DEBUG(LOG_CORE, "api metrics map is empty, nothing to backup");
+    HILOG_DEBUG(LOG_CORE, "Backup start: input count=%{public}zu", apiStats.size());
+    std::vector<AppEventCacheCommon::ApiStatsRecord> records;
+    records.reserve(apiStats.size());
+    for (const auto& [descriptor, stats] : apiStats) {
+        if (stats.callTimes > 0) {
+            records.emplace_back(ToRecord(descriptor, stats));
+        }
+    }
+    if (records.empty()) {
+        HILOG_DEBUG(LOG_CORE, "api stats map is empty, nothing to backup");
         return DB_SUCC;
     }
 
-    auto& appEventStore = AppEventStore::GetInstance();
-    for (const auto& [descriptor, metrics] : apiMetrics) {
-        std::string kitName = descriptor.KitName();
-        std::string apiName = descriptor.ApiName();
-
-        HILOG_DEBUG(LOG_CORE, "Backup: kitName=%{public}s, apiName=%{public}s, metrics=%{public}zu",
-            kitName.c_str(), apiName.c_str(), metrics.size());
-
-        for (const auto& metric : metrics) {
-            Json::Value metricObj(Json::objectValue);
-            metricObj["errCode"] = metric.errCode;
-            metricObj["duration"] = metric.duration;
-            metricObj["successful"] = metric.successful;
-            std::string metricJson = Json::FastWriter().write(metricObj);
-
-            int ret = appEventStore.InsertApiMetricInfo(kitName, apiName, metricJson);
-            HILOG_DEBUG(LOG_CORE, "insert metric, kitName=%{public}s, apiName=%{public}s, ret=%{public}d",
-                kitName.c_str(), apiName.c_str(), ret);
-            if (ret != NativeRdb::E_OK) {
-                HILOG_ERROR(LOG_CORE, "failed to backup api metric, kitName=%{public}s, apiName=%{public}s, \
-                    ret=%{public}d", kitName.c_str(), apiName.c_str(), ret);
-                return DB_FAILED;
-            }
-        }
+    if (int ret = AppEventStore::GetInstance().InsertApiStats(records); ret != NativeRdb::E_OK) {
+        HILOG_ERROR(LOG_CORE, "failed to backup api stats, count=%{public}zu, ret=%{public}d", records.size(), ret);
+        return DB_FAILED;
     }
-    HILOG_INFO(LOG_CORE, "backup api stats success, count=%{public}zu", apiMetrics.size());
+    HILOG_INFO(LOG_CORE, "backup api stats success, count=%{public}zu", records.size());
     return DB_SUCC;
 }
 
-int ApiStatsStorage::QueryAll(ApiMetricsMap& apiMetrics)
+int ApiStatsStorage::QueryAll(ApiStatsMap& apiStats)
 {
     HILOG_DEBUG(LOG_CORE, "QueryAll start");
-    auto& appEventStore = AppEventStore::GetInstance();
-    apiMetrics.clear();
-
-    std::map<std::pair<std::string, std::string>, std::vector<std::string>> results;
-    int ret = appEventStore.QueryApiMetricInfoAll(results);
-    if (ret != NativeRdb::E_OK) {
+    std::vector<AppEventCacheCommon::ApiStatsRecord> records;
+    if (int ret = AppEventStore::GetInstance().QueryApiStats(records); ret != NativeRdb::E_OK) {
         HILOG_ERROR(LOG_CORE, "failed to query all api stats, ret=%{public}d", ret);
         return DB_FAILED;
     }
+    ToApiStatsMap(records, apiStats);
+    HILOG_INFO(LOG_CORE, "query all api stats success, count=%{public}zu", apiStats.size());
+    return DB_SUCC;
+}
 
-    HILOG_DEBUG(LOG_CORE, "QueryAll: db result count=%{public}zu", results.size());
-    for (const auto& [key, metricJsons] : results) {
-        const auto& [kitName, apiName] = key;
-        std::vector<ApiMetric> metrics;
-        for (const auto& metricJson : metricJsons) {
-            Json::Value jsonValue;
-            Json::Reader reader(Json::Features::strictMode());
-            if (!reader.parse(metricJson, jsonValue)) {
-                HILOG_WARN(LOG_CORE, "failed to parse metric json, kitName=%{public}s, apiName=%{public}s",
-                    kitName.c_str(), apiName.c_str());
-                continue;
-            }
-            if (!jsonValue["errCode"].isInt() || !jsonValue["duration"].isInt() || !jsonValue["successful"].isBool()) {
-                HILOG_ERROR(LOG_CORE, "query all failed to parse json");
-                continue;
-            }
-            int errCode = jsonValue["errCode"].asInt();
-            int duration = jsonValue["duration"].asInt();
-            bool successful = jsonValue["successful"].asBool();
-            if (duration < 0) {
-                HILOG_ERROR(LOG_CORE, "query all, duration param error");
-                continue;
-            }
-            HILOG_DEBUG(LOG_CORE, "parse metric, kitName=%{public}s, apiName=%{public}s, errCode=%{public}d, "
-                "duration=%{public}d, successful=%{public}d",
-                kitName.c_str(), apiName.c_str(), errCode, duration, successful);
-            metrics.emplace_back(ApiMetric{errCode, duration, successful});
-        }
-
-        ApiDescriptor descriptor(kitName, apiName);
-        apiMetrics[descriptor] = std::move(metrics);
+int ApiStatsStorage::TakeAll(ApiStatsMap& apiStats)
+{
+    HILOG_DEBUG(LOG_CORE, "TakeAll start");
+    std::vector<AppEventCacheCommon::ApiStatsRecord> records;
+    if (int ret = AppEventStore::GetInstance().TakeApiStats(records); ret != NativeRdb::E_OK) {
+        HILOG_ERROR(LOG_CORE, "failed to take all api stats, ret=%{public}d", ret);
+        return DB_FAILED;
     }
-
-    HILOG_INFO(LOG_CORE, "query all api stats success, count=%{public}zu", apiMetrics.size());
+    ToApiStatsMap(records, apiStats);
+    HILOG_INFO(LOG_CORE, "take all api stats success, count=%{public}zu", apiStats.size());
     return DB_SUCC;
 }
 
 int ApiStatsStorage::Clear()
 {
     HILOG_DEBUG(LOG_CORE, "Clear start");
-    auto& appEventStore = AppEventStore::GetInstance();
-    int ret = appEventStore.ClearApiMetricInfo();
+    int ret = AppEventStore::GetInstance().ClearApiStats();
     HILOG_INFO(LOG_CORE, "clear api stats, ret=%{public}d", ret);
     return ret == NativeRdb::E_OK ? DB_SUCC : DB_FAILED;
 }
@@ -44,8 +44,7 @@ int ApiMetricProcessor::ProcessApiMetric(const HiAppEvent::ApiInfo& apiInfo, con
     if (metric.duration < 0 || apiInfo.kit.empty() || apiInfo.api.empty()) {
         return ErrorCode::ERROR_INVALID_PARAM_VALUE;
     }
-    ApiDescriptor descriptor(apiInfo.kit, apiInfo.api);
-    apiStatsMgr_.AddRecord(descriptor, metric);
+    apiStatsMgr_.AddRecord(apiInfo.kit, apiInfo.api, metric);
     return ErrorCode::HIAPPEVENT_VERIFY_SUCCESSFUL;
 }
 
@@ -17,9 +17,10 @@
 #define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_STAT_INCLUDE_API_STATS_AGGREGATOR_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 
-#include "api_stats_types.h"
+#include "api_stats_map.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -40,15 +41,20 @@ struct ApiStatsReport {
 
 class ApiStatsAggregator {
 public:
-    void Record(ApiDescriptor descriptor, ApiMetric metric);
+    void Record(const ApiDescriptor& descriptor, const ApiMetric& metric);
+    void Record(std::string_view kitName, std::string_view apiName, const ApiMetric& metric);
+    void Merge(const ApiStatsMap& apiStats);
     void ClearRecord();
     void MarkAsBackuped();
     bool IsUpdatedAfterLastBackup();
-    ApiMetricsMap GetApiMetrics() const;
-    static std::vector<ApiStatsReport> AggregateStats(const ApiMetricsMap& apiMetrics);
+    ApiStatsMap GetApiStats() const;
+
+    // moves out the records, the aggregator is empty and marked as backuped after it
+    ApiStatsMap TakeApiStats();
+    static std::vector<ApiStatsReport> AggregateStats(const ApiStatsMap& apiStats);
  
 private:
-    ApiMetricsMap apiMetricsMap_;
+    ApiStatsMap apiStatsMap_;
     bool updatedAfterLastBackup_ = false;
  
     void MarkAsUpdated();
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_STAT_INCLUDE_API_STATS_MAP_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_STAT_INCLUDE_API_STATS_MAP_H
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "api_stats_types.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace HiAppEvent {
+/*
+ * The open addressing map from the api to its statistics. The entries are kept in the insertion order,
+ * and an api can be looked up by the views of its names, so the descriptor is built only when it is inserted.
+ */
+class ApiStatsMap {
+public:
+    using Entry = std::pair<ApiDescriptor, ApiStats>;
+    using iterator = std::vector<Entry>::iterator;
+    using const_iterator = std::vector<Entry>::const_iterator;
+
+    ApiStats& operator[](const ApiDescriptor& descriptor);
+
+    // returns the statistics of the api, which are inserted if the api does not exist
+    ApiStats& Get(std::string_view kitName, std::string_view apiName);
+
+    iterator find(const ApiDescriptor& descriptor);
+    const_iterator find(const ApiDescriptor& descriptor) const;
+
+    iterator begin()
+    {
+        return entries_.begin();
+    }
+
+    iterator end()
+    {
+        return entries_.end();
+    }
+
+    const_iterator begin() const
+    {
+        return entries_.begin();
+    }
+
+    const_iterator end() const
+    {
+        return entries_.end();
+    }
+
+    size_t size() const
+    {
+        return entries_.size();
+    }
+
+    bool empty() const
+    {
+        return entries_.empty();
+    }
+
+    void clear();
+    void swap(ApiStatsMap& other);
+
+private:
+    ApiStats& GetOrInsert(std::string_view kitName, std::string_view apiName, size_t hash);
+    size_t FindSlot(std::string_view kitName, std::string_view apiName, size_t hash) const;
+    void Rehash(size_t capacity);
+
+private:
+    // the index of the entry plus one is stored in the slot, 0 means the slot is empty
+    static constexpr uint32_t EMPTY_SLOT = 0;
+    static constexpr size_t MIN_CAPACITY = 16;
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> slots_;
+};
+} // namespace HiAppEvent
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_STAT_INCLUDE_API_STATS_MAP_H
@@ -16,9 +16,11 @@
 #ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_STAT_INCLUDE_API_STATS_MGR_H
 #define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_STAT_INCLUDE_API_STATS_MGR_H
 
+#include <array>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
 
 #include "api_stats_types.h"
 #include "api_stats_aggregator.h"
@@ -34,17 +36,33 @@ class ApiStatsManager {
 public:
     ApiStatsManager();
     ~ApiStatsManager();
-    void AddRecord(ApiDescriptor descriptor, ApiMetric metric);
+    void AddRecord(std::string_view kitName, std::string_view apiName, const ApiMetric& metric);
 
 private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+    static constexpr size_t SHARD_NUM = 16;
+
+    // the records of a thread are kept by its own shard, so the recording threads rarely wait for each other
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::mutex mutex;
+        ApiStatsAggregator aggregator;
+    };
+
+    Shard& GetShard();
+    void CollectShards();
     void ScheduleBackUp();
     void ScheduleBackUpInner();
     void ScheduleReport();
     void ReportStats(const std::vector<ApiStatsReport>& reports);
     std::shared_ptr<AppEventPack> ConvertReportToEventPack(const ApiStatsReport& report);
 
+    std::array<Shard, SHARD_NUM> shards_;
+
+    // the records collected from the shards and not backuped yet
     ApiStatsAggregator aggregator_;
     ApiStatsTimer timer_;
+
+    // serializes the backup and report, it is not taken by the recording threads
     std::mutex mut_;
 };
 
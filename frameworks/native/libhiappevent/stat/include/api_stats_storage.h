@@ -16,7 +16,7 @@
 #ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_STAT_INCLUDE_API_STATS_STORAGE_H
 #define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_STAT_INCLUDE_API_STATS_STORAGE_H
 
-#include "api_stats_types.h"
+#include "api_stats_map.h"
 #include "nocopyable.h"
 
 namespace OHOS {
@@ -27,8 +27,14 @@ class ApiStatsStorage : public NoCopyable {
 public:
     static ApiStatsStorage& GetInstance();
 
-    int Backup(const ApiMetricsMap& apiMetrics);
-    int QueryAll(ApiMetricsMap& apiMetrics);
+    // stores one row of the aggregated statistics for each api
+    int Backup(const ApiStatsMap& apiStats);
+
+    // merges the rows of each api stored by the backups
+    int QueryAll(ApiStatsMap& apiStats);
+
+    // merges the rows of each api and deletes all the rows at once
+    int TakeAll(ApiStatsMap& apiStats);
     int Clear();
 
 private:
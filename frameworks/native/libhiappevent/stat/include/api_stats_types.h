@@ -16,8 +16,13 @@
 #ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_STAT_INCLUDE_API_STATS_TYPES_H
 #define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_STAT_INCLUDE_API_STATS_TYPES_H
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "base_type.h"
@@ -28,16 +33,17 @@ namespace HiAppEvent {
 
 class ApiDescriptor {
 public:
-    ApiDescriptor(const std::string& kitName, const std::string& apiName) : kitName_(kitName), apiName_(apiName) {}
+    ApiDescriptor(std::string_view kitName, std::string_view apiName)
+        : kitName_(kitName), apiName_(apiName), hash_(HashOf(kitName, apiName)) {}
     
-    std::string KitName() const
+    const std::string& KitName() const
     {
-        return std::string(kitName_);
+        return kitName_;
     }
     
-    std::string ApiName() const
+    const std::string& ApiName() const
     {
-        return std::string(apiName_);
+        return apiName_;
     }
 
     std::string Description() const
@@ -45,19 +51,84 @@ public:
         return kitName_ + ':' + apiName_;
     }
 
+    size_t Hash() const
+    {
+        return hash_;
+    }
+
+    bool Equals(std::string_view kitName, std::string_view apiName) const
+    {
+        return kitName_ == kitName && apiName_ == apiName;
+    }
+
+    static size_t HashOf(std::string_view kitName, std::string_view apiName)
+    {
+        // combines the hashes in the way of boost::hash_combine
+        constexpr size_t hashSeed = 0x9e3779b9;
+        constexpr size_t leftShift = 6;
+        constexpr size_t rightShift = 2;
+        size_t hash = std::hash<std::string_view>()(kitName);
+        return hash ^ (std::hash<std::string_view>()(apiName) + hashSeed + (hash << leftShift) + (hash >> rightShift));
+    }
+
     struct ApiDescriptorComparator {
         bool operator() (const ApiDescriptor& lApi, const ApiDescriptor& rApi) const
         {
-            return lApi.Description() < rApi.Description();
+            int ret = lApi.kitName_.compare(rApi.kitName_);
+            return ret != 0 ? ret < 0 : lApi.apiName_ < rApi.apiName_;
         }
     };
     
 private:
-    const std::string kitName_;
-    const std::string apiName_;
+    std::string kitName_;
+    std::string apiName_;
+    size_t hash_ = 0;
 };
 
-using ApiMetricsMap = std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator>;
+// the statistics of the calls of an api, updated by each call instead of keeping the calls
+struct ApiStats {
+    /* The number of the calls */
+    int callTimes = 0;
+
+    /* The number of the successful calls */
+    int successTimes = 0;
+
+    /* The max cost time of the calls */
+    int64_t maxCostTime = 0;
+
+    /* The min cost time of the calls */
+    int64_t minCostTime = std::numeric_limits<int64_t>::max();
+
+    /* The total cost time of the calls */
+    int64_t totalCostTime = 0;
+
+    /* The number of the calls of each error code */
+    std::map<int, int> errorCodeNum;
+
+    void Merge(const ApiMetric& metric)
+    {
+        ++callTimes;
+        if (metric.successful) {
+            ++successTimes;
+        }
+        maxCostTime = std::max(maxCostTime, static_cast<int64_t>(metric.duration));
+        minCostTime = std::min(minCostTime, static_cast<int64_t>(metric.duration));
+        totalCostTime += metric.duration;
+        ++errorCodeNum[metric.errCode];
+    }
+
+    void Merge(const ApiStats& stats)
+    {
+        callTimes += stats.callTimes;
+        successTimes += stats.successTimes;
+        maxCostTime = std::max(maxCostTime, stats.maxCostTime);
+        minCostTime = std::min(minCostTime, stats.minCostTime);
+        totalCostTime += stats.totalCostTime;
+        for (const auto& [errCode, num] : stats.errorCodeNum) {
+            errorCodeNum[errCode] += num;
+        }
+    }
+};
 
 } // namespace HiAppEvent
 } // namespace HiviewDFX
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "app_event_log_writer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "file_util.h"
+#include "time_util.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr mode_t FILE_PERM_600 = S_IRUSR | S_IWUSR;
+constexpr uint32_t MAX_FILE_INDEX = 999;
+constexpr size_t MAX_IOV_NUM = IOV_MAX;
+
+std::string GetLogFileName(const std::string& date, uint32_t index)
+{
+    if (index == 0) {
+        return "app_event_" + date + ".log";
+    }
+    constexpr size_t indexSize = 5; // for '_001\0'
+    char indexStr[indexSize] = {0};
+    if (snprintf(indexStr, sizeof(indexStr), "_%03u", index) < 0) {
+        return "app_event_" + date + ".log";
+    }
+    return "app_event_" + date + indexStr + ".log";
+}
+}
+
+AppEventLogWriter::~AppEventLogWriter()
+{
+    Close();
+}
+
+bool AppEventLogWriter::Write(const std::string& dir, const std::vector<std::string>& contents)
+{
+    uint64_t writeSize = 0;
+    for (const auto& content : contents) {
+        writeSize += content.size();
+    }
+    if (writeSize == 0) {
+        return true;
+    }
+    if (!PrepareFile(dir, writeSize)) {
+        return false;
+    }
+    if (!WriteContents(contents)) {
+        // reopen the file on the next writing
+        Close();
+        return false;
+    }
+    fileSize_ += writeSize;
+    SyncFile();
+    return true;
+}
+
+void AppEventLogWriter::SetConfig(const LogWriterConfig& config)
+{
+    config_ = config;
+}
+
+LogWriterConfig AppEventLogWriter::GetConfig() const
+{
+    return config_;
+}
+
+std::string AppEventLogWriter::GetFilePath() const
+{
+    return filePath_;
+}
+
+int AppEventLogWriter::GetLastErrno() const
+{
+    return lastErrno_;
+}
+
+void AppEventLogWriter::Close()
+{
+    if (fd_ < 0) {
+        return;
+    }
+    if (config_.syncPolicy != LogSyncPolicy::NONE) {
+        fdatasync(fd_);
+    }
+    close(fd_);
+    fd_ = -1;
+    filePath_.clear();
+    fileSize_ = 0;
+}
+
+bool AppEventLogWriter::PrepareFile(const std::string& dir, uint64_t writeSize)
+{
+    // the date is cached by TimeUtil, which is cleared when the time zone or the time is changed
+    std::string date = TimeUtil::GetDate();
+    if (fd_ >= 0 && (dir != dir_ || date != date_ || !IsFileValid())) {
+        Close();
+    }
+    if (fd_ < 0) {
+        // continue to write the latest log file of the day
+        uint32_t index = 0;
+        while (index < MAX_FILE_INDEX && FileUtil::IsFileExists(
+            FileUtil::GetFilePathByDir(dir, GetLogFileName(date, index + 1)))) {
+            ++index;
+        }
+        fileIndex_ = index;
+        if (!OpenFile(dir, date, fileIndex_)) {
+            return false;
+        }
+    }
+    if (fileSize_ > 0 && fileSize_ + writeSize > config_.maxFileSize && fileIndex_ < MAX_FILE_INDEX) {
+        Close();
+        return OpenFile(dir, date, fileIndex_ + 1);
+    }
+    return true;
+}
+
+bool AppEventLogWriter::OpenFile(const std::string& dir, const std::string& date, uint32_t index)
+{
+    std::string filePath = FileUtil::GetFilePathByDir(dir, GetLogFileName(date, index));
+    int fd = open(filePath.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, FILE_PERM_600);
+    if (fd < 0) {
+        lastErrno_ = errno;
+        return false;
+    }
+    struct stat statBuf {};
+    if (fstat(fd, &statBuf) != 0) {
+        lastErrno_ = errno;
+        close(fd);
+        return false;
+    }
+    fd_ = fd;
+    dir_ = dir;
+    date_ = date;
+    filePath_ = filePath;
+    fileIndex_ = index;
+    fileSize_ = static_cast<uint64_t>(statBuf.st_size);
+    return true;
+}
+
+bool AppEventLogWriter::IsFileValid()
+{
+    // the file may be deleted by the cleaner while it is still opened
+    struct stat statBuf {};
+    return fstat(fd_, &statBuf) == 0 && statBuf.st_nlink > 0;
+}
+
+bool AppEventLogWriter::WriteContents(const std::vector<std::string>& contents)
+{
+    std::vector<struct iovec> iovs;
+    iovs.reserve(std::min(contents.size(), MAX_IOV_NUM));
+    size_t index = 0;
+    while (index < contents.size()) {
+        iovs.clear();
+        for (; index < contents.size() && iovs.size() < MAX_IOV_NUM; ++index) {
+            if (!contents[index].empty()) {
+                iovs.push_back({ const_cast<char*>(contents[index].data()), contents[index].size() });
+            }
+        }
+        size_t iovIndex = 0;
+        while (iovIndex < iovs.size()) {
+            ssize_t ret = writev(fd_, &iovs[iovIndex], static_cast<int>(iovs.size() - iovIndex));
+            if (ret < 0 && errno == EINTR) {
+                continue;
+            }
+            if (ret <= 0) {
+                // nothing is written without an error, e.g. the device has no space
+                lastErrno_ = ret < 0 ? errno : ENOSPC;
+                return false;
+            }
+            // skip the written data if only part of the data is written
+            size_t written = static_cast<size_t>(ret);
+            while (iovIndex < iovs.size() && written >= iovs[iovIndex].iov_len) {
+                written -= iovs[iovIndex].iov_len;
+                ++iovIndex;
+            }
+            if (iovIndex < iovs.size()) {
+                iovs[iovIndex].iov_base = static_cast<char*>(iovs[iovIndex].iov_base) + written;
+                iovs[iovIndex].iov_len -= written;
+            }
+        }
+    }
+    return true;
+}
+
+void AppEventLogWriter::SyncFile()
+{
+    switch (config_.syncPolicy) {
+        case LogSyncPolicy::PER_BATCH:
+            fdatasync(fd_);
+            break;
+        case LogSyncPolicy::PERIODIC: {
+            uint64_t now = TimeUtil::GetMilliseconds();
+            if (now >= lastSyncTime_ + config_.syncIntervalMs) {
+                fdatasync(fd_);
+                lastSyncTime_ = now;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+} // namespace HiviewDFX
+} // namespace OHOS
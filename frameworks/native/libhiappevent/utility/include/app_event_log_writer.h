@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_APP_EVENT_LOG_WRITER_H
+#define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_APP_EVENT_LOG_WRITER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+enum class LogSyncPolicy {
+    NONE = 0,
+    PER_BATCH = 1,
+    PERIODIC = 2,
+};
+
+struct LogWriterConfig {
+    /* The size of a log file that triggers the rotation to a new file */
+    uint64_t maxFileSize = 1024 * 1024; // 1M
+
+    /* The policy of flushing the written data to the storage device */
+    LogSyncPolicy syncPolicy = LogSyncPolicy::NONE;
+
+    /* The min interval in milliseconds between two flushes, used by LogSyncPolicy::PERIODIC */
+    uint64_t syncIntervalMs = 5 * 1000; // 5s
+};
+
+/*
+ * Keeps the log file of the current day open and appends the events to it.
+ * The writer is not thread safe, callers must serialize the calls.
+ */
+class AppEventLogWriter : public NoCopyable {
+public:
+    AppEventLogWriter() = default;
+    ~AppEventLogWriter();
+    bool Write(const std::string& dir, const std::vector<std::string>& contents);
+    void SetConfig(const LogWriterConfig& config);
+    LogWriterConfig GetConfig() const;
+    std::string GetFilePath() const;
+    // returns the errno of the last failed writing, captured right after the failed system call
+    int GetLastErrno() const;
+    void Close();
+
+private:
+    bool PrepareFile(const std::string& dir, uint64_t writeSize);
+    bool OpenFile(const std::string& dir, const std::string& date, uint32_t index);
+    bool IsFileValid();
+    bool WriteContents(const std::vector<std::string>& contents);
+    void SyncFile();
+
+private:
+    int fd_ = -1;
+    std::string dir_;
+    std::string date_;
+    std::string filePath_;
+    uint32_t fileIndex_ = 0;
+    uint64_t fileSize_ = 0;
+    uint64_t lastSyncTime_ = 0;
+    int lastErrno_ = 0;
+    LogWriterConfig config_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_APP_EVENT_LOG_WRITER_H
@@ -16,6 +16,7 @@
 #define HIAPPEVENT_FRAMEWORKS_NATIVE_LIB_HIAPPEVENT_UTILITY_SQL_UTIL_H
 
 #include <string>
+#include <vector>
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -25,6 +26,9 @@ constexpr const char* SQL_INT_TYPE = "INTEGER";
 
 std::string CreateTable(const std::string& table,
     const std::vector<std::pair<std::string, std::string>>& fields);
+std::string Insert(const std::string& table, const std::vector<std::string>& fields);
+std::string CreateIndex(const std::string& table, const std::string& indexName,
+    const std::vector<std::string>& fields);
 } // namespace SqlUtil
 } // namespace HiviewDFX
 } // namespace OHOS
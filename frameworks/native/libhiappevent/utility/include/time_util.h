@@ -23,6 +23,9 @@ namespace TimeUtil {
 uint64_t GetMilliseconds();
 std::string GetDate();
 std::string GetTimeZone();
+
+// the date and time zone are cached until the next 15 minutes boundary, clears the cache if the time zone is changed
+void ClearLocalTimeCache();
 int64_t GetMilliSecondsTimestamp(clockid_t clockId);
 int64_t GetElapsedMilliSecondsSinceBoot();
 } // namespace TimeUtil
@@ -27,6 +27,28 @@ std::string CreateTable(const std::string& table, const std::vector<std::pair<st
     sql += ")";
     return sql;
 }
+
+std::string Insert(const std::string& table, const std::vector<std::string>& fields)
+{
+    // the values are bound by position, so the statement can be reused for each row
+    std::string sql = "INSERT INTO " + table + "(";
+    std::string values = " VALUES(";
+    for (size_t i = 0; i < fields.size(); ++i) {
+        sql += (i == 0 ? "" : ", ") + fields[i];
+        values += (i == 0 ? "?" : ", ?");
+    }
+    return sql + ")" + values + ")";
+}
+
+std::string CreateIndex(const std::string& table, const std::string& indexName,
+    const std::vector<std::string>& fields)
+{
+    std::string sql = "CREATE INDEX IF NOT EXISTS " + indexName + " ON " + table + "(";
+    for (size_t i = 0; i < fields.size(); ++i) {
+        sql += (i == 0 ? "" : ", ") + fields[i];
+    }
+    return sql + ")";
+}
 } // namespace SqlUtil
 } // namespace HiviewDFX
 } // namespace OHOS
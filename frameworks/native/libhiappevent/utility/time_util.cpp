@@ -16,13 +16,67 @@
 
 #include <chrono>
 #include <ctime>
-#include <sys/time.h>
+#include <memory>
 
 namespace OHOS {
 namespace HiviewDFX {
 namespace TimeUtil {
 namespace {
 constexpr const char* DEFAULT_DATE = "19700101";
+constexpr time_t LOCAL_TIME_CACHE_SEC = 15 * 60; // the offsets of time zones and DST are multiples of 15 minutes
+
+struct LocalTimeCache {
+    /* The cache is valid in [beginTime, endTime), in seconds since the epoch */
+    time_t beginTime = 0;
+    time_t endTime = 0;
+
+    /* The local date formatted as 19700101 */
+    std::string date;
+
+    /* The offset of the local time zone formatted as +0800 */
+    std::string timeZone;
+};
+
+std::shared_ptr<const LocalTimeCache> g_localTimeCache;
+
+std::shared_ptr<const LocalTimeCache> CreateLocalTimeCache(time_t nowTime)
+{
+    struct tm localTm;
+    if (localtime_noenv_r(&nowTime, &localTm) == nullptr) {
+        return nullptr;
+    }
+    char dateChs[9] = { 0 }; // 9 means 8(19700101) + 1('\0')
+    if (strftime(dateChs, sizeof(dateChs), "%Y%m%d", &localTm) == 0) {
+        return nullptr;
+    }
+    constexpr size_t buffSize = 6; // for '+0800\0'
+    char timeZoneChs[buffSize] = { 0 };
+    if (strftime(timeZoneChs, sizeof(timeZoneChs), "%z", &localTm) == 0) {
+        return nullptr;
+    }
+    // the day and DST boundaries are on the 15 minutes boundaries, so the cache expires at the next one
+    auto cache = std::make_shared<LocalTimeCache>();
+    cache->beginTime = nowTime - nowTime % LOCAL_TIME_CACHE_SEC;
+    cache->endTime = cache->beginTime + LOCAL_TIME_CACHE_SEC;
+    cache->date = dateChs;
+    cache->timeZone = timeZoneChs;
+    return cache;
+}
+
+std::shared_ptr<const LocalTimeCache> GetLocalTimeCache()
+{
+    time_t nowTime = time(nullptr);
+    if (nowTime < 0) {
+        return nullptr;
+    }
+    auto cache = std::atomic_load(&g_localTimeCache);
+    if (cache != nullptr && nowTime >= cache->beginTime && nowTime < cache->endTime) {
+        return cache;
+    }
+    cache = CreateLocalTimeCache(nowTime);
+    std::atomic_store(&g_localTimeCache, cache);
+    return cache;
+}
 }
 uint64_t GetMilliseconds()
 {
@@ -33,38 +87,19 @@ uint64_t GetMilliseconds()
 
 std::string GetDate()
 {
-    time_t nowTime = time(nullptr);
-    if (nowTime < 0) {
-        return DEFAULT_DATE;
-    }
-    char dateChs[9] = { 0 }; // 9 means 8(19700101) + 1('\0')
-    struct tm localTm;
-    if (localtime_noenv_r(&nowTime, &localTm) == nullptr) {
-        return DEFAULT_DATE;
-    }
-    if (strftime(dateChs, sizeof(dateChs), "%Y%m%d", &localTm) == 0) {
-        return DEFAULT_DATE;
-    }
-    return dateChs;
+    auto cache = GetLocalTimeCache();
+    return cache == nullptr ? DEFAULT_DATE : cache->date;
 }
 
 std::string GetTimeZone()
 {
-    struct timeval tv;
-    if (gettimeofday(&tv, nullptr) != 0) {
-        return "";
-    }
-    time_t sysSec = tv.tv_sec;
-    struct tm tmLocal;
-    if (localtime_noenv_r(&sysSec, &tmLocal) == nullptr) {
-        return "";
-    }
-    constexpr size_t buffSize = 6; // for '+0800\0'
-    char buff[buffSize] = {0};
-    if (strftime(buff, sizeof(buff), "%z", &tmLocal) == 0) {
-        return "";
-    }
-    return std::string(buff);
+    auto cache = GetLocalTimeCache();
+    return cache == nullptr ? "" : cache->timeZone;
+}
+
+void ClearLocalTimeCache()
+{
+    std::atomic_store(&g_localTimeCache, std::shared_ptr<const LocalTimeCache>());
 }
 
 int64_t GetMilliSecondsTimestamp(clockid_t clockId)
@@ -15,6 +15,7 @@
 #ifndef HIAPPEVENT_INTERFACES_NATIVE_INNER_API_INCLUDE_APP_EVENT_PROCESSOR_H
 #define HIAPPEVENT_INTERFACES_NATIVE_INNER_API_INCLUDE_APP_EVENT_PROCESSOR_H
 
+#include <memory>
 #include <string>
 
 #include "base_type.h"
@@ -30,6 +31,17 @@ struct AppEventInfo {
     std::string params;
 };
 
+/*
+ * The completion token of an asynchronous report, Complete() should be called once when the report ends.
+ * The result 0 means the events are reported successfully and can be deleted.
+ */
+class ReportCompletion {
+public:
+    ReportCompletion() = default;
+    virtual ~ReportCompletion() = default;
+    virtual void Complete(int result) = 0;
+};
+
 class AppEventProcessor {
 public:
     AppEventProcessor() = default;
@@ -44,6 +56,35 @@ public:
     virtual int ValidateUserProperty(const UserProperty& userProperty) = 0;
     virtual int ValidateEvent(const AppEventInfo& event) = 0;
 };
+
+/*
+ * The processor which reports the events asynchronously, it is registered by
+ * AppEventProcessorMgr::RegisterAsyncProcessor. It is a separate class so that the layout of the virtual table of
+ * AppEventProcessor keeps unchanged for the existing processors.
+ */
+class AppEventAsyncProcessor : public AppEventProcessor {
+public:
+    AppEventAsyncProcessor() = default;
+    ~AppEventAsyncProcessor() override = default;
+
+    // the events of the asynchronous processor are reported by OnReportAsync instead
+    int OnReport(
+        int64_t processorSeq,
+        const std::vector<UserId>& userIds,
+        const std::vector<UserProperty>& userProperties,
+        const std::vector<AppEventInfo>& events) override
+    {
+        return -1;
+    }
+
+    // completion->Complete() should be called once when the report ends
+    virtual void OnReportAsync(
+        int64_t processorSeq,
+        const std::vector<UserId>& userIds,
+        const std::vector<UserProperty>& userProperties,
+        const std::vector<AppEventInfo>& events,
+        std::shared_ptr<ReportCompletion> completion) = 0;
+};
 } // namespace HiAppEvent
 } // namespace HiviewDFX
 } // namespace OHOS
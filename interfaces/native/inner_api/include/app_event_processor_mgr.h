@@ -67,6 +67,18 @@ public:
  *         is already registered).
 */
     static int RegisterProcessor(const std::string& name, std::shared_ptr<AppEventProcessor> processor);
+
+/**
+ * @brief Registers an AppEventAsyncProcessor object, whose events are reported by OnReportAsync.
+ *
+ * @param name specifies the name of an AppEventAsyncProcessor object.
+ * @param processor smart pointer to the AppEventAsyncProcessor object.
+ * @return Returns 0 if the registration is successful; otherwise, returns a negative integer(returns -1 if the name
+ *         is already registered).
+ * @note At most 4 reports of a processor are in progress at the same time, and the events of a failed report are
+ *       reported again after a backoff delay.
+*/
+    static int RegisterAsyncProcessor(const std::string& name, std::shared_ptr<AppEventAsyncProcessor> processor);
 /**
  * @brief Unregisters an AppEventProcessor object.
  *
@@ -66,6 +66,15 @@ int AppEventProcessorMgr::RegisterProcessor(const std::string& name, std::shared
     return AppEventObserverFacade::RegisterProcessor(name, processor);
 }
 
+int AppEventProcessorMgr::RegisterAsyncProcessor(const std::string& name,
+    std::shared_ptr<AppEventAsyncProcessor> processor)
+{
+    if (!AppEventVerifyFacade::VerifyIsApp()) {
+        return ErrorCode::ERROR_NOT_APP;
+    }
+    return AppEventObserverFacade::RegisterAsyncProcessor(name, processor);
+}
+
 int AppEventProcessorMgr::UnregisterProcessor(const std::string& name)
 {
     if (!AppEventVerifyFacade::VerifyIsApp()) {
@@ -16,6 +16,7 @@
 #include "hiappevent_api_metric_test.h"
 
 #include <iostream>
+#include <thread>
 
 #define private public
 #include "api_stats_mgr.h"
@@ -48,6 +49,17 @@ constexpr int TEST_DURATION2 = 200;
 constexpr bool TEST_SUCCESSFUL = true;
 constexpr bool TEST_SUCCESSFUL2 = false;
 constexpr int32_t TEST_UID = 200000 * 100;
+constexpr int MANY_API_NUM = 1000;
+constexpr int MANY_API_CALL_TIMES = 3;
+
+// the map compared by the descriptions used before, as the baseline of the stats
+struct LegacyComparator {
+    bool operator() (const ApiDescriptor& lApi, const ApiDescriptor& rApi) const
+    {
+        return lApi.Description() < rApi.Description();
+    }
+};
+using LegacyApiStatsMap = std::map<ApiDescriptor, ApiStats, LegacyComparator>;
 }
 
 void HiAppEventApiMetricTest::SetUpTestCase()
@@ -98,23 +110,22 @@ HWTEST_F(HiAppEventApiMetricTest, ReportApiMetricTest001, TestSize.Level0)
     metric.successful = true;
 
     HiAppEvent::ApiStatsManager ApiStatsMgr;
-    HiAppEvent::ApiDescriptor descriptor(apiInfo.kit, apiInfo.api);
-    ApiStatsMgr.AddRecord(descriptor, metric);
+    ApiStatsMgr.AddRecord(apiInfo.kit, apiInfo.api, metric);
     ApiStatsMgr.ScheduleBackUp();
-    std::map<std::pair<std::string, std::string>, std::vector<std::string>> outBackUp;
-    int ret = AppEventStore::GetInstance().QueryApiMetricInfoAll(outBackUp);
+    std::vector<AppEventCacheCommon::ApiStatsRecord> outBackUp;
+    int ret = AppEventStore::GetInstance().QueryApiStats(outBackUp);
     EXPECT_EQ(ret, OHOS::NativeRdb::E_OK);
     EXPECT_EQ(outBackUp.size(), 1);
 
     
     ApiStatsMgr.ScheduleReport();
-    std::map<std::pair<std::string, std::string>, std::vector<std::string>> outReport;
-    ret = AppEventStore::GetInstance().QueryApiMetricInfoAll(outReport);
+    std::vector<AppEventCacheCommon::ApiStatsRecord> outReport;
+    ret = AppEventStore::GetInstance().QueryApiStats(outReport);
     EXPECT_EQ(ret, OHOS::NativeRdb::E_OK);
     EXPECT_EQ(outReport.size(), 0);
 
     ApiStatsMgr.ScheduleReport();
-    ret = AppEventStore::GetInstance().QueryApiMetricInfoAll(outReport);
+    ret = AppEventStore::GetInstance().QueryApiStats(outReport);
     EXPECT_EQ(ret, OHOS::NativeRdb::E_OK);
     EXPECT_EQ(outReport.size(), 0);
 }
@@ -304,17 +315,17 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest001, TestSize.Level0)
     /**
      * @tc.steps: step1. create ApiStatsAggregator.
      * @tc.steps: step2. call Record() with single metric.
-     * @tc.steps: step3. check the result with GetApiMetrics().
+     * @tc.steps: step3. check the result with GetApiStats().
      */
     ApiStatsAggregator aggregator;
     ApiDescriptor descriptor(TEST_KIT, TEST_API);
     ApiMetric metric{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL};
     aggregator.Record(descriptor, metric);
     
-    auto apiMetrics = aggregator.GetApiMetrics();
+    auto apiMetrics = aggregator.GetApiStats();
     EXPECT_EQ(apiMetrics.size(), 1);
     EXPECT_TRUE(apiMetrics.find(descriptor) != apiMetrics.end());
-    EXPECT_EQ(apiMetrics[descriptor].size(), 1);
+    EXPECT_EQ(apiMetrics[descriptor].callTimes, 1);
 }
 
 /**
@@ -336,9 +347,9 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest002, TestSize.Level0)
     aggregator.Record(descriptor, metric1);
     aggregator.Record(descriptor, metric2);
     
-    auto apiMetrics = aggregator.GetApiMetrics();
+    auto apiMetrics = aggregator.GetApiStats();
     EXPECT_EQ(apiMetrics.size(), 1);
-    EXPECT_EQ(apiMetrics[descriptor].size(), 2);
+    EXPECT_EQ(apiMetrics[descriptor].callTimes, 2);
 }
 
 /**
@@ -360,10 +371,10 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest003, TestSize.Level0)
     aggregator.Record(descriptor1, metric);
     aggregator.Record(descriptor2, metric);
     
-    auto apiMetrics = aggregator.GetApiMetrics();
+    auto apiMetrics = aggregator.GetApiStats();
     EXPECT_EQ(apiMetrics.size(), 2);
-    EXPECT_EQ(apiMetrics[descriptor1].size(), 1);
-    EXPECT_EQ(apiMetrics[descriptor2].size(), 1);
+    EXPECT_EQ(apiMetrics[descriptor1].callTimes, 1);
+    EXPECT_EQ(apiMetrics[descriptor2].callTimes, 1);
 }
 
 /**
@@ -376,7 +387,7 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest004, TestSize.Level0)
     /**
      * @tc.steps: step1. create ApiStatsEntity and add records.
      * @tc.steps: step2. call ClearRecord().
-     * @tc.steps: step3. check GetApiMetrics() is empty.
+     * @tc.steps: step3. check GetApiStats() is empty.
      */
     ApiStatsAggregator aggregator;
     ApiDescriptor descriptor(TEST_KIT, TEST_API);
@@ -384,7 +395,7 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest004, TestSize.Level0)
     aggregator.Record(descriptor, metric);
     aggregator.ClearRecord();
     
-    auto apiMetrics = aggregator.GetApiMetrics();
+    auto apiMetrics = aggregator.GetApiStats();
     EXPECT_EQ(apiMetrics.size(), 0);
 }
 
@@ -454,10 +465,10 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest008, TestSize.Level0)
      * @tc.steps: step2. call AggregateStats().
      * @tc.steps: step3. check the aggregated result.
      */
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> apiMetrics;
+    ApiStatsMap apiMetrics;
     ApiDescriptor descriptor(TEST_KIT, TEST_API);
     ApiMetric metric{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL};
-    apiMetrics[descriptor].push_back(metric);
+    apiMetrics[descriptor].Merge(metric);
     
     auto reports = ApiStatsAggregator::AggregateStats(apiMetrics);
     EXPECT_EQ(reports.size(), 1);
@@ -482,12 +493,12 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest009, TestSize.Level0)
      * @tc.steps: step2. call AggregateStats().
      * @tc.steps: step3. check the aggregated statistics.
      */
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> apiMetrics;
+    ApiStatsMap apiMetrics;
     ApiDescriptor descriptor(TEST_KIT, TEST_API);
     ApiMetric metric1{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL};
     ApiMetric metric2{TEST_ERR_CODE2, TEST_DURATION2, TEST_SUCCESSFUL2};
-    apiMetrics[descriptor].push_back(metric1);
-    apiMetrics[descriptor].push_back(metric2);
+    apiMetrics[descriptor].Merge(metric1);
+    apiMetrics[descriptor].Merge(metric2);
     
     auto reports = ApiStatsAggregator::AggregateStats(apiMetrics);
     EXPECT_EQ(reports.size(), 1);
@@ -510,14 +521,14 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsAggregatorTest010, TestSize.Level0)
      * @tc.steps: step2. call AggregateStats().
      * @tc.steps: step3. check the error code statistics.
      */
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> apiMetrics;
+    ApiStatsMap apiMetrics;
     ApiDescriptor descriptor(TEST_KIT, TEST_API);
     ApiMetric metric1{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL};
     ApiMetric metric2{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL2};
     ApiMetric metric3{TEST_ERR_CODE2, TEST_DURATION2, TEST_SUCCESSFUL2};
-    apiMetrics[descriptor].push_back(metric1);
-    apiMetrics[descriptor].push_back(metric2);
-    apiMetrics[descriptor].push_back(metric3);
+    apiMetrics[descriptor].Merge(metric1);
+    apiMetrics[descriptor].Merge(metric2);
+    apiMetrics[descriptor].Merge(metric3);
     
     auto reports = ApiStatsAggregator::AggregateStats(apiMetrics);
     EXPECT_EQ(reports.size(), 1);
@@ -537,7 +548,7 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsStorageTest001, TestSize.Level0)
      * @tc.steps: step2. call Backup().
      * @tc.steps: step3. check return value.
      */
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> apiMetrics;
+    ApiStatsMap apiMetrics;
     int ret = ApiStatsStorage::GetInstance().Backup(apiMetrics);
     EXPECT_EQ(ret, 0);
 }
@@ -554,10 +565,10 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsStorageTest002, TestSize.Level0)
      * @tc.steps: step2. call Backup().
      * @tc.steps: step3. check return value.
      */
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> apiMetrics;
+    ApiStatsMap apiMetrics;
     ApiDescriptor descriptor(TEST_KIT, TEST_API);
     ApiMetric metric{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL};
-    apiMetrics[descriptor].push_back(metric);
+    apiMetrics[descriptor].Merge(metric);
     
     int ret = ApiStatsStorage::GetInstance().Backup(apiMetrics);
     EXPECT_EQ(ret, 0);
@@ -577,14 +588,14 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsStorageTest003, TestSize.Level0)
      * @tc.steps: step2. call QueryAll().
      * @tc.steps: step3. check the queried data.
      */
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> apiMetrics;
+    ApiStatsMap apiMetrics;
     ApiDescriptor descriptor(TEST_KIT, TEST_API);
     ApiMetric metric{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL};
-    apiMetrics[descriptor].push_back(metric);
+    apiMetrics[descriptor].Merge(metric);
     
     ApiStatsStorage::GetInstance().Backup(apiMetrics);
     
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> queriedMetrics;
+    ApiStatsMap queriedMetrics;
     int ret = ApiStatsStorage::GetInstance().QueryAll(queriedMetrics);
     EXPECT_EQ(ret, 0);
     EXPECT_EQ(queriedMetrics.size(), 1);
@@ -604,15 +615,15 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsStorageTest004, TestSize.Level0)
      * @tc.steps: step2. call Clear().
      * @tc.steps: step3. QueryAll and check empty result.
      */
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> apiMetrics;
+    ApiStatsMap apiMetrics;
     ApiDescriptor descriptor(TEST_KIT, TEST_API);
     ApiMetric metric{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL};
-    apiMetrics[descriptor].push_back(metric);
+    apiMetrics[descriptor].Merge(metric);
     
     ApiStatsStorage::GetInstance().Backup(apiMetrics);
     ApiStatsStorage::GetInstance().Clear();
     
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> queriedMetrics;
+    ApiStatsMap queriedMetrics;
     int ret = ApiStatsStorage::GetInstance().QueryAll(queriedMetrics);
     EXPECT_EQ(ret, 0);
     EXPECT_EQ(queriedMetrics.size(), 0);
@@ -630,18 +641,18 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsStorageTest005, TestSize.Level0)
      * @tc.steps: step2. QueryAll and verify data.
      * @tc.steps: step3. Clear and verify empty.
      */
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> apiMetrics;
+    ApiStatsMap apiMetrics;
     ApiDescriptor descriptor1(TEST_KIT, TEST_API);
     ApiDescriptor descriptor2(TEST_KIT2, TEST_API2);
     ApiMetric metric1{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL};
     ApiMetric metric2{TEST_ERR_CODE2, TEST_DURATION2, TEST_SUCCESSFUL2};
-    apiMetrics[descriptor1].push_back(metric1);
-    apiMetrics[descriptor2].push_back(metric2);
-    apiMetrics[descriptor2].push_back(metric2);
+    apiMetrics[descriptor1].Merge(metric1);
+    apiMetrics[descriptor2].Merge(metric2);
+    apiMetrics[descriptor2].Merge(metric2);
     
     EXPECT_EQ(ApiStatsStorage::GetInstance().Backup(apiMetrics), 0);
     
-    std::map<ApiDescriptor, std::vector<ApiMetric>, ApiDescriptor::ApiDescriptorComparator> queriedMetrics;
+    ApiStatsMap queriedMetrics;
     EXPECT_EQ(ApiStatsStorage::GetInstance().QueryAll(queriedMetrics), 0);
     EXPECT_EQ(queriedMetrics.size(), 2);
     
@@ -833,36 +844,46 @@ HWTEST_F(HiAppEventApiMetricTest, ProcessApiMetricTest004, TestSize.Level0)
 
 /**
  * @tc.name: ApiStatsStorageTest006
- * @tc.desc: check the ApiStatsStorage QueryAll with invalid json in database
+ * @tc.desc: check the ApiStatsStorage QueryAll with invalid records in database
  * @tc.type: FUNC
  */
 HWTEST_F(HiAppEventApiMetricTest, ApiStatsStorageTest006, TestSize.Level0)
 {
     /**
      * @tc.steps: step1. init db store
-     * @tc.steps: step2. insert invalid json metric directly
+     * @tc.steps: step2. insert the valid record and the invalid records of other apis directly
      * @tc.steps: step3. call QueryAll() to trigger parse failure
-     * @tc.steps: step4. verify invalid json is skipped
+     * @tc.steps: step4. verify the invalid records are skipped
      */
     AppEventStore::GetInstance().InitDbStore();
 
-    std::string invalidJson = "{invalid json";
-    AppEventStore::GetInstance().InsertApiMetricInfo(TEST_KIT, TEST_API, invalidJson);
-
-    std::string invalidJsonValue = "{\"errCode\":0,\"duration\":-1,\"successful\":true}";
-    AppEventStore::GetInstance().InsertApiMetricInfo(TEST_KIT, TEST_API, invalidJsonValue);
-
-    std::string validJson = "{\"errCode\":0,\"duration\":100,\"successful\":true}";
-    AppEventStore::GetInstance().InsertApiMetricInfo(TEST_KIT, TEST_API, validJson);
-
-    std::string invalidErrCode = "{\"errCode\":\"validVlue\",\"duration\":100,\"successful\":true}";
-    std::string invalidDuration = "{\"errCode\":0,\"duration\":\"validVlue\",\"successful\":true}";
-    std::string invalidSuccessful = "{\"errCode\":0,\"duration\":100,\"successful\":\"validVlue\"}";
-    AppEventStore::GetInstance().InsertApiMetricInfo(TEST_KIT, TEST_API, invalidErrCode);
-    AppEventStore::GetInstance().InsertApiMetricInfo(TEST_KIT, TEST_API, invalidDuration);
-    AppEventStore::GetInstance().InsertApiMetricInfo(TEST_KIT, TEST_API, invalidSuccessful);
-
-    ApiMetricsMap queriedMetrics;
+    AppEventCacheCommon::ApiStatsRecord validRecord;
+    validRecord.kitName = TEST_KIT;
+    validRecord.apiName = TEST_API;
+    validRecord.callTimes = 1;
+    validRecord.successTimes = 1;
+    validRecord.maxCostTime = TEST_DURATION;
+    validRecord.minCostTime = TEST_DURATION;
+    validRecord.totalCostTime = TEST_DURATION;
+    validRecord.errorCodes = "0:1";
+
+    auto invalidErrorCodes = validRecord;
+    invalidErrorCodes.apiName = "invalid_error_codes";
+    invalidErrorCodes.errorCodes = "validVlue:1";
+    auto invalidErrorNum = validRecord;
+    invalidErrorNum.apiName = "invalid_error_num";
+    invalidErrorNum.errorCodes = "0:-1";
+    auto invalidCostTime = validRecord;
+    invalidCostTime.apiName = "invalid_cost_time";
+    invalidCostTime.minCostTime = -1;
+    auto invalidSuccessTimes = validRecord;
+    invalidSuccessTimes.apiName = "invalid_success_times";
+    invalidSuccessTimes.successTimes = validRecord.callTimes + 1;
+    AppEventStore::GetInstance().InsertApiStats({
+        validRecord, invalidErrorCodes, invalidErrorNum, invalidCostTime, invalidSuccessTimes
+    });
+
+    ApiStatsMap queriedMetrics;
     int ret = ApiStatsStorage::GetInstance().QueryAll(queriedMetrics);
     EXPECT_EQ(ret, 0);
     EXPECT_EQ(queriedMetrics.size(), 1);
@@ -870,3 +891,155 @@ HWTEST_F(HiAppEventApiMetricTest, ApiStatsStorageTest006, TestSize.Level0)
     ApiStatsStorage::GetInstance().Clear();
     AppEventStore::GetInstance().DestroyDbStore();
 }
+
+/**
+ * @tc.name: ApiStatsStorageTest007
+ * @tc.desc: check the ApiStatsStorage backups the stats of the calls and takes the merged stats
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventApiMetricTest, ApiStatsStorageTest007, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. backup the stats of many calls twice
+     * @tc.steps: step2. check the rows of the api are merged into one record by the db
+     * @tc.steps: step3. call TakeAll() and check the merged stats
+     * @tc.steps: step4. check the rows are deleted
+     */
+    constexpr int callNum = 1000;
+    ApiStatsMap apiStats;
+    ApiDescriptor descriptor(TEST_KIT, TEST_API);
+    for (int i = 0; i < callNum; ++i) {
+        apiStats[descriptor].Merge(ApiMetric{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL});
+    }
+    apiStats[descriptor].Merge(ApiMetric{TEST_ERR_CODE2, TEST_DURATION2, TEST_SUCCESSFUL2});
+    EXPECT_EQ(ApiStatsStorage::GetInstance().Backup(apiStats), 0);
+    EXPECT_EQ(ApiStatsStorage::GetInstance().Backup(apiStats), 0);
+
+    std::vector<AppEventCacheCommon::ApiStatsRecord> records;
+    EXPECT_EQ(AppEventStore::GetInstance().QueryApiStats(records), OHOS::NativeRdb::E_OK);
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0].callTimes, (callNum + 1) * 2);
+
+    ApiStatsMap takenStats;
+    EXPECT_EQ(ApiStatsStorage::GetInstance().TakeAll(takenStats), 0);
+    ASSERT_EQ(takenStats.size(), 1);
+    const auto& stats = takenStats.begin()->second;
+    EXPECT_EQ(stats.callTimes, (callNum + 1) * 2);
+    EXPECT_EQ(stats.successTimes, callNum * 2);
+    EXPECT_EQ(stats.maxCostTime, TEST_DURATION2);
+    EXPECT_EQ(stats.minCostTime, TEST_DURATION);
+    EXPECT_EQ(stats.totalCostTime, (callNum * TEST_DURATION + TEST_DURATION2) * 2);
+    EXPECT_EQ(stats.errorCodeNum.size(), 2);
+    EXPECT_EQ(stats.errorCodeNum.at(TEST_ERR_CODE), callNum * 2);
+    EXPECT_EQ(stats.errorCodeNum.at(TEST_ERR_CODE2), 2);
+
+    ApiStatsMap queriedStats;
+    EXPECT_EQ(ApiStatsStorage::GetInstance().QueryAll(queriedStats), 0);
+    EXPECT_TRUE(queriedStats.empty());
+}
+
+/**
+ * @tc.name: ReportApiMetricTest006
+ * @tc.desc: check the records added by multiple threads are all backuped
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventApiMetricTest, ReportApiMetricTest006, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. add the records in multiple threads while backuping
+     * @tc.steps: step2. call ScheduleBackUp() after the threads exit
+     * @tc.steps: step3. check the number of the calls stored
+     */
+    constexpr int threadNum = 8;
+    constexpr int recordNum = 1000;
+    HiAppEvent::ApiStatsManager apiStatsMgr;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadNum; ++i) {
+        threads.emplace_back([&apiStatsMgr] {
+            for (int j = 0; j < recordNum; ++j) {
+                apiStatsMgr.AddRecord(TEST_KIT, TEST_API, ApiMetric{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL});
+            }
+        });
+    }
+    threads.emplace_back([&apiStatsMgr] {
+        for (int i = 0; i < threadNum; ++i) {
+            apiStatsMgr.ScheduleBackUp();
+        }
+    });
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    apiStatsMgr.ScheduleBackUp();
+
+    ApiStatsMap queriedStats;
+    EXPECT_EQ(ApiStatsStorage::GetInstance().QueryAll(queriedStats), 0);
+    ASSERT_EQ(queriedStats.size(), 1);
+    EXPECT_EQ(queriedStats.begin()->second.callTimes, threadNum * recordNum);
+
+    ApiStatsStorage::GetInstance().Clear();
+}
+
+/**
+ * @tc.name: ApiStatsMapTest001
+ * @tc.desc: check the ApiStatsMap looks up the apis by the descriptors and the names.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventApiMetricTest, ApiStatsMapTest001, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. insert the apis by the descriptors and the names.
+     * @tc.steps: step2. check the apis are found and kept in the insertion order.
+     * @tc.steps: step3. check the map is empty after clear.
+     */
+    ApiStatsMap apiStats;
+    ApiDescriptor descriptor(TEST_KIT, TEST_API);
+    EXPECT_TRUE(apiStats.find(descriptor) == apiStats.end());
+    apiStats[descriptor].Merge(ApiMetric{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL});
+    apiStats.Get(TEST_KIT, TEST_API).Merge(ApiMetric{TEST_ERR_CODE, TEST_DURATION, TEST_SUCCESSFUL});
+    apiStats.Get(TEST_KIT2, TEST_API2).Merge(ApiMetric{TEST_ERR_CODE2, TEST_DURATION2, TEST_SUCCESSFUL2});
+    ASSERT_EQ(apiStats.size(), 2);
+    EXPECT_EQ(apiStats[descriptor].callTimes, 2);
+    EXPECT_EQ(apiStats.begin()->first.KitName(), TEST_KIT);
+    EXPECT_EQ((apiStats.begin() + 1)->first.ApiName(), TEST_API2);
+    EXPECT_EQ(apiStats.find(ApiDescriptor(TEST_KIT2, TEST_API2))->second.callTimes, 1);
+    EXPECT_TRUE(apiStats.find(ApiDescriptor(TEST_KIT, TEST_API2)) == apiStats.end());
+
+    apiStats.clear();
+    EXPECT_TRUE(apiStats.empty());
+    EXPECT_TRUE(apiStats.find(descriptor) == apiStats.end());
+}
+
+/**
+ * @tc.name: ApiStatsMapTest002
+ * @tc.desc: check the ApiStatsMap keeps the same stats as the legacy map when it grows to 1k apis.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventApiMetricTest, ApiStatsMapTest002, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. record the calls of 1k apis by the legacy map and the ApiStatsMap.
+     * @tc.steps: step2. check the stats of each api are the same.
+     */
+    std::vector<std::pair<std::string, std::string>> apis;
+    for (int i = 0; i < MANY_API_NUM; ++i) {
+        apis.emplace_back("many_kit_" + std::to_string(i % 10), "many_api_" + std::to_string(i)); // 10 kits
+    }
+    LegacyApiStatsMap legacyStats;
+    ApiStatsMap apiStats;
+    for (int i = 0; i < MANY_API_CALL_TIMES; ++i) {
+        ApiMetric metric{i, TEST_DURATION + i, TEST_SUCCESSFUL};
+        for (const auto& [kit, api] : apis) {
+            legacyStats[ApiDescriptor(kit, api)].Merge(metric);
+            apiStats.Get(kit, api).Merge(metric);
+        }
+    }
+
+    ASSERT_EQ(apiStats.size(), legacyStats.size());
+    for (const auto& [descriptor, stats] : legacyStats) {
+        auto it = apiStats.find(descriptor);
+        ASSERT_TRUE(it != apiStats.end());
+        EXPECT_EQ(it->second.callTimes, MANY_API_CALL_TIMES);
+        EXPECT_EQ(it->second.totalCostTime, stats.totalCostTime);
+        EXPECT_EQ(it->second.errorCodeNum, stats.errorCodeNum);
+    }
+}
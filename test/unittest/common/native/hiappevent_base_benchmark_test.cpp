@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "hiappevent_base.h"
+#include "hiappevent_legacy_serializer.h"
+
+using namespace testing::ext;
+using namespace OHOS::HiviewDFX;
+using namespace OHOS::HiviewDFX::LegacySerializer;
+
+namespace {
+constexpr int PARAM_NUM = 32;
+constexpr int PARAM_KIND_NUM = 4;
+constexpr int LOOP_TIMES = 10000;
+
+class HiAppEventBaseBenchmarkTest : public testing::Test {
+public:
+    void SetUp() {}
+    void TearDown() {}
+};
+
+std::vector<std::pair<std::string, AppEventParamValue>> CreateParams()
+{
+    std::vector<std::pair<std::string, AppEventParamValue>> params;
+    for (int i = 0; i < PARAM_NUM; ++i) {
+        std::string name = "param_" + std::to_string(i);
+        switch (i % PARAM_KIND_NUM) {
+            case 0:
+                params.emplace_back(name, i * 1000); // 1000 for a multi-digit value
+                break;
+            case 1:
+                params.emplace_back(name, "value_" + std::to_string(i));
+                break;
+            case 2:
+                params.emplace_back(name, i * 1.25); // 1.25 for a value with fractional part
+                break;
+            default:
+                params.emplace_back(name, std::vector<int>{i, -i, i * i});
+                break;
+        }
+    }
+    return params;
+}
+
+std::shared_ptr<AppEventPack> CreateEvent(const std::vector<std::pair<std::string, AppEventParamValue>>& params)
+{
+    auto event = std::make_shared<AppEventPack>("benchmark_domain", "benchmark_name", 1);
+    AppEventParams baseParams;
+    for (const auto& [name, value] : params) {
+        baseParams.emplace_back(name, value);
+    }
+    event->SetBaseParams(std::move(baseParams));
+    return event;
+}
+
+template<typename Func>
+int64_t MeasureMicroseconds(Func&& func)
+{
+    auto beginTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < LOOP_TIMES; ++i) {
+        func();
+    }
+    auto endTime = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(endTime - beginTime).count();
+}
+}
+
+/**
+ * @tc.name: AppEventPack_SerializeBenchmark001
+ * @tc.desc: check the param string is the same as the legacy serialization and compare the cost.
+ * @tc.type: PERF
+ */
+HWTEST_F(HiAppEventBaseBenchmarkTest, AppEventPack_SerializeBenchmark001, TestSize.Level1)
+{
+    auto params = CreateParams();
+    auto event = CreateEvent(params);
+    ASSERT_EQ(event->GetParamStr(), GetLegacyParamStr(params));
+    ASSERT_EQ(event->GetEventStr(), GetLegacyEventStr(*event, params));
+
+    size_t totalSize = 0;
+    int64_t legacyCost = MeasureMicroseconds([&params, &totalSize]() {
+        totalSize += GetLegacyParamStr(params).size();
+    });
+    int64_t currentCost = MeasureMicroseconds([&event, &totalSize]() {
+        totalSize += event->GetParamStr().size();
+    });
+    int64_t eventCost = MeasureMicroseconds([&event, &totalSize]() {
+        totalSize += event->GetEventStr().size();
+    });
+    std::cout << "serialize " << PARAM_NUM << " params " << LOOP_TIMES << " times, legacy=" << legacyCost
+        << "us, current=" << currentCost << "us, event=" << eventCost << "us, size=" << totalSize << std::endl;
+    EXPECT_GT(totalSize, 0);
+}
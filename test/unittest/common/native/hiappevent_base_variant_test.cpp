@@ -15,13 +15,18 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
+#include <memory>
+#include <string>
 #include <variant>
 #include <vector>
 
 #include "hiappevent_base.h"
+#include "hiappevent_legacy_serializer.h"
 
 using namespace testing::ext;
 using namespace OHOS::HiviewDFX;
+using namespace OHOS::HiviewDFX::LegacySerializer;
 
 namespace {
 class HiAppEventBaseVariantTest : public testing::Test {
@@ -29,6 +34,52 @@ public:
     void SetUp() {}
     void TearDown() {}
 };
+
+std::shared_ptr<AppEventPack> CreateEventWithParams()
+{
+    auto event = std::make_shared<AppEventPack>("testDomain", "testName", 1);
+    event->AddParam("intKey", 42);
+    event->AddParam("strKey", std::string("hello"));
+    event->AddParam("doubleKey", 1.25);
+    event->AddParam("vecKey", std::vector<int>{1, 2, 3});
+    return event;
+}
+
+// the params of all the types with the boundary values, used to check the output is the same as before
+std::vector<std::pair<std::string, AppEventParamValue>> CreateParamsOfAllTypes()
+{
+    return {
+        {"bool_true", true}, {"bool_false", false},
+        {"char", 'a'}, {"char_zero", static_cast<char>(0)},
+        {"short_min", std::numeric_limits<int16_t>::min()}, {"short_max", std::numeric_limits<int16_t>::max()},
+        {"int_min", std::numeric_limits<int>::min()}, {"int_zero", 0}, {"int_max", std::numeric_limits<int>::max()},
+        {"int64_min", std::numeric_limits<int64_t>::min()}, {"int64_max", std::numeric_limits<int64_t>::max()},
+        {"float", 1.5f}, {"float_int", 100.0f}, {"float_small", 0.0001f}, {"float_neg", -2.25f},
+        {"float_max", std::numeric_limits<float>::max()},
+        {"double", 3.14159}, {"double_zero", 0.0}, {"double_int", 10.0}, {"double_small", 1e-7},
+        {"double_neg", -1234.5}, {"double_big", 1e20},
+        {"string", std::string("value")}, {"string_empty", std::string()},
+        {"bools", std::vector<bool>{true, false, true}}, {"bools_empty", std::vector<bool>{}},
+        {"chars", std::vector<char>{'a', 'b'}}, {"chars_empty", std::vector<char>{}},
+        {"shorts", std::vector<int16_t>{-1, 0, std::numeric_limits<int16_t>::max()}},
+        {"ints", std::vector<int>{std::numeric_limits<int>::min(), 0, 1}}, {"ints_empty", std::vector<int>{}},
+        {"int64s", std::vector<int64_t>{std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()}},
+        {"floats", std::vector<float>{0.5f, -1.0f, 3.0f}}, {"floats_empty", std::vector<float>{}},
+        {"doubles", std::vector<double>{0.25, -1.0, 1e-7}}, {"doubles_empty", std::vector<double>{}},
+        {"strings", std::vector<std::string>{"a", "", "c"}}, {"strings_empty", std::vector<std::string>{}},
+    };
+}
+
+std::shared_ptr<AppEventPack> CreateEvent(const std::vector<std::pair<std::string, AppEventParamValue>>& params)
+{
+    auto event = std::make_shared<AppEventPack>("test_domain", "test_name", 1);
+    AppEventParams baseParams;
+    for (const auto& [name, value] : params) {
+        baseParams.emplace_back(name, value);
+    }
+    event->SetBaseParams(std::move(baseParams));
+    return event;
+}
 }
 
 /**
@@ -544,3 +595,121 @@ HWTEST_F(HiAppEventBaseVariantTest, AppEventPack_GetCustomParams001, TestSize.Le
         }
     }
 }
+
+/**
+ * @tc.name: AppEventPack_EventStrCache001
+ * @tc.desc: check the cached event string is refreshed after the event is changed.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventBaseVariantTest, AppEventPack_EventStrCache001, TestSize.Level0)
+{
+    auto event = CreateEventWithParams();
+    std::string eventStr = event->GetEventStr();
+    EXPECT_EQ(event->GetEventSize(), eventStr.size());
+    EXPECT_EQ(event->GetEventStr(), eventStr);
+
+    event->AddParam("new_param", 1);
+    std::string newEventStr = event->GetEventStr();
+    EXPECT_NE(newEventStr, eventStr);
+    EXPECT_NE(newEventStr.find("\"new_param\":1"), std::string::npos);
+    EXPECT_EQ(event->GetEventSize(), newEventStr.size());
+
+    event->SetName("new_name");
+    EXPECT_NE(event->GetEventStr().find("\"name_\":\"new_name\""), std::string::npos);
+    event->SetTime(0);
+    EXPECT_NE(event->GetEventStr().find("\"time_\":0"), std::string::npos);
+    event->SetSeq(1); // the seq is not a part of the event string
+    EXPECT_EQ(event->GetEventSize(), event->GetEventStr().size());
+}
+
+/**
+ * @tc.name: AppEventPack_Symbol001
+ * @tc.desc: check the domain and name of events are interned.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventBaseVariantTest, AppEventPack_Symbol001, TestSize.Level0)
+{
+    auto event1 = std::make_shared<AppEventPack>("symbol_domain", "symbol_name", 1);
+    auto event2 = std::make_shared<AppEventPack>("symbol_domain", "symbol_name", 1);
+    ASSERT_NE(event1->GetDomainId(), AppEventSymbol::INVALID_ID);
+    ASSERT_EQ(event1->GetDomainId(), event2->GetDomainId());
+    ASSERT_EQ(event1->GetNameId(), event2->GetNameId());
+    ASSERT_NE(event1->GetDomainId(), event1->GetNameId());
+    ASSERT_EQ(&event1->GetName(), &event2->GetName());
+    ASSERT_EQ(AppEventSymbol::FindId("symbol_name"), event1->GetNameId());
+
+    event2->SetName("symbol_name2");
+    ASSERT_EQ(event2->GetName(), "symbol_name2");
+    ASSERT_NE(event1->GetNameId(), event2->GetNameId());
+
+    AppEventPack emptyEvent;
+    ASSERT_TRUE(emptyEvent.GetDomain().empty());
+    ASSERT_EQ(emptyEvent.GetDomainId(), AppEventSymbol("").GetId());
+}
+
+/**
+ * @tc.name: AppEventPack_MoveParams001
+ * @tc.desc: check the params are moved into and out of the event.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventBaseVariantTest, AppEventPack_MoveParams001, TestSize.Level0)
+{
+    constexpr size_t paramNum = 4; // 4 means the number of the params added by CreateEventWithParams
+    auto event = CreateEventWithParams();
+    ASSERT_EQ(event->GetBaseParams().size(), paramNum);
+    std::string eventStr = event->GetEventStr();
+
+    AppEventParams baseParams = event->TakeBaseParams();
+    ASSERT_EQ(baseParams.size(), paramNum);
+    ASSERT_TRUE(event->GetBaseParams().empty());
+    ASSERT_NE(event->GetEventStr(), eventStr);
+
+    const void* data = baseParams.data();
+    event->SetBaseParams(std::move(baseParams));
+    ASSERT_EQ(event->GetBaseParams().data(), data);
+    ASSERT_EQ(event->GetEventStr(), eventStr);
+
+    // the params are appended to the existing params
+    AppEventParams newParams;
+    newParams.emplace_back("new_param", 1);
+    event->SetBaseParams(std::move(newParams));
+    ASSERT_EQ(event->GetBaseParams().size(), paramNum + 1);
+    ASSERT_EQ(event->GetBaseParams().back().name, "new_param");
+}
+
+/**
+ * @tc.name: AppEventPack_SerializeParity001
+ * @tc.desc: check the param and event strings of all the param types are the same as the legacy serialization.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventBaseVariantTest, AppEventPack_SerializeParity001, TestSize.Level0)
+{
+    auto params = CreateParamsOfAllTypes();
+    auto event = CreateEvent(params);
+    ASSERT_EQ(event->GetParamStr(), GetLegacyParamStr(params));
+    ASSERT_EQ(event->GetEventStr(), GetLegacyEventStr(*event, params));
+
+    // each param alone, so that a mismatch is reported with the type
+    for (const auto& param : params) {
+        std::vector<std::pair<std::string, AppEventParamValue>> singleParams = { param };
+        auto singleEvent = CreateEvent(singleParams);
+        ASSERT_EQ(singleEvent->GetParamStr(), GetLegacyParamStr(singleParams)) << "param=" << param.first;
+    }
+
+    // the event with the trace info
+    event->SetTraceId(0x1234); // 0x1234 for a valid trace id
+    event->SetSpanId(1);
+    event->SetPspanId(2); // 2 for the parent span id
+    event->SetTraceFlag(1);
+    ASSERT_EQ(event->GetEventStr(), GetLegacyEventStr(*event, params));
+
+    // the event from the db, whose params are stored as the param string
+    auto dbEvent = CreateEvent({});
+    dbEvent->SetParamStr(GetLegacyParamStr(params));
+    ASSERT_EQ(dbEvent->GetEventStr(), GetLegacyEventStr(*dbEvent, params));
+
+    // the event without params
+    auto emptyEvent = CreateEvent({});
+    ASSERT_EQ(emptyEvent->GetParamStr(), GetLegacyParamStr({}));
+    ASSERT_EQ(emptyEvent->GetEventStr(), GetLegacyEventStr(*emptyEvent, {}));
+}
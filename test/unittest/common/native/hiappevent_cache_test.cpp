@@ -15,13 +15,17 @@
 
 #include "hiappevent_cache_test.h"
 
-#include <json/json.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unistd.h>
 
 #include "api_stats_dao.h"
 #include "app_event_cache_common.h"
 #include "app_event_db_cleaner.h"
 #include "app_event_log_cleaner.h"
 #include "app_event_stat.h"
+#include "app_event_statement.h"
 #include "app_event_store.h"
 #include "app_event_store_callback.h"
 #include "file_util.h"
@@ -51,10 +55,23 @@ const std::string TEST_API_KIT = "test_api_kit";
 const std::string TEST_API_NAME = "test_api_name";
 const std::string TEST_API_KIT2 = "test_api_kit2";
 const std::string TEST_API_NAME2 = "test_api_name2";
-const std::string TEST_METRIC_JSON = "{\"errCode\":0,\"duration\":100,\"successful\":true}";
-const std::string TEST_METRIC_JSON2 = "{\"errCode\":1,\"duration\":200,\"successful\":false}";
 constexpr int WRITE_SUCCESS = 0;
 
+ApiStatsRecord CreateApiStatsRecord(const std::string& kitName, const std::string& apiName, int64_t costTime,
+    const std::string& errorCodes)
+{
+    ApiStatsRecord record;
+    record.kitName = kitName;
+    record.apiName = apiName;
+    record.callTimes = 1;
+    record.successTimes = 1;
+    record.maxCostTime = costTime;
+    record.minCostTime = costTime;
+    record.totalCostTime = costTime;
+    record.errorCodes = errorCodes;
+    return record;
+}
+
 std::shared_ptr<AppEventPack> CreateAppEventPack()
 {
     return std::make_shared<AppEventPack>(TEST_EVENT_DOMAIN, TEST_EVENT_NAME, TEST_EVENT_TYPE);
@@ -335,6 +352,513 @@ HWTEST_F(HiAppEventCacheTest, HiAppEventDBTest006, TestSize.Level0)
     ASSERT_EQ(result, 0);
 }
 
+/**
+ * @tc.name: HiAppEventDBTest007
+ * @tc.desc: check the result of inserting events in one transaction.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventDBTest007, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. open the db.
+     * @tc.steps: step2. insert events and the mapping records in one transaction.
+     * @tc.steps: step3. query records from tables.
+     */
+    int result = AppEventStore::GetInstance().InitDbStore();
+    ASSERT_EQ(result, 0);
+    int64_t observerSeq = AppEventStore::GetInstance().InsertObserver(AppEventCacheCommon::Observer(TEST_OBSERVER_NAME,
+        0, ""));
+    ASSERT_GT(observerSeq, 0);
+
+    constexpr size_t eventNum = 3;
+    std::vector<std::shared_ptr<AppEventPack>> events;
+    std::vector<std::vector<int64_t>> observerSeqs;
+    for (size_t i = 0; i < eventNum; ++i) {
+        auto event = CreateAppEventPack();
+        event->AddParam("index", static_cast<int>(i));
+        events.emplace_back(event);
+        // the last event is not mapped to the observer
+        observerSeqs.emplace_back(i + 1 < eventNum ? std::vector<int64_t>{observerSeq} : std::vector<int64_t>{});
+    }
+    result = AppEventStore::GetInstance().InsertEvents(events, observerSeqs);
+    ASSERT_EQ(result, DB_SUCC);
+    for (size_t i = 0; i < eventNum; ++i) {
+        ASSERT_GT(events[i]->GetSeq(), 0);
+        if (i > 0) {
+            ASSERT_GT(events[i]->GetSeq(), events[i - 1]->GetSeq());
+        }
+    }
+
+    std::vector<std::shared_ptr<AppEventPack>> queryEvents;
+    result = AppEventStore::GetInstance().QueryEvents(queryEvents, observerSeq);
+    ASSERT_EQ(result, 0);
+    ASSERT_EQ(queryEvents.size(), eventNum - 1);
+    // the events are queried in descending order of seq
+    for (size_t i = 0; i < queryEvents.size(); ++i) {
+        ASSERT_EQ(queryEvents[i]->GetSeq(), events[queryEvents.size() - 1 - i]->GetSeq());
+        ASSERT_EQ(queryEvents[i]->GetParamStr(), events[queryEvents.size() - 1 - i]->GetParamStr());
+    }
+
+    std::vector<std::shared_ptr<AppEventPack>> emptyEvents;
+    ASSERT_EQ(AppEventStore::GetInstance().InsertEvents(emptyEvents), DB_SUCC);
+
+    result = AppEventStore::GetInstance().DestroyDbStore();
+    ASSERT_EQ(result, 0);
+}
+
+/**
+ * @tc.name: HiAppEventDBTest008
+ * @tc.desc: check the cached custom params are refreshed after the custom params are changed.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventDBTest008, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. open the db, insert custom params.
+     * @tc.steps: step2. add the custom params to events several times.
+     * @tc.steps: step3. update and delete the custom params, add the custom params to events again.
+     */
+    int result = AppEventStore::GetInstance().InitDbStore();
+    ASSERT_EQ(result, 0);
+    auto eventParams = CreateAppEventPack();
+    eventParams->SetRunningId(TEST_RUNNING_ID);
+    eventParams->AddParam("custom_data", "value_old_str");
+    ASSERT_EQ(AppEventStore::GetInstance().InsertCustomEventParams(eventParams), 0);
+
+    for (int i = 0; i < 2; ++i) { // 2 means the second query hits the cache
+        auto event = CreateAppEventPack();
+        event->SetRunningId(TEST_RUNNING_ID);
+        ASSERT_EQ(AppEventStore::GetInstance().QueryCustomParamsAdd2EventPack(event), DB_SUCC);
+        ASSERT_EQ(event->GetParamStr(), "{\"custom_data\":\"value_old_str\"}\n");
+    }
+
+    eventParams->AddParam("custom_data", "value_new_str");
+    ASSERT_EQ(AppEventStore::GetInstance().InsertCustomEventParams(eventParams), 0);
+    auto event = CreateAppEventPack();
+    event->SetRunningId(TEST_RUNNING_ID);
+    ASSERT_EQ(AppEventStore::GetInstance().QueryCustomParamsAdd2EventPack(event), DB_SUCC);
+    ASSERT_EQ(event->GetParamStr(), "{\"custom_data\":\"value_new_str\"}\n");
+
+    AppEventStore::GetInstance().DeleteCustomEventParams();
+    event = CreateAppEventPack();
+    event->SetRunningId(TEST_RUNNING_ID);
+    ASSERT_EQ(AppEventStore::GetInstance().QueryCustomParamsAdd2EventPack(event), DB_SUCC);
+    ASSERT_EQ(event->GetParamStr(), "{}\n");
+
+    result = AppEventStore::GetInstance().DestroyDbStore();
+    ASSERT_EQ(result, 0);
+}
+
+/**
+ * @tc.name: HiAppEventDBTest009
+ * @tc.desc: check the pending events of the observers in EventStorageMode::CURSOR.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventDBTest009, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. open the db in EventStorageMode::CURSOR, add two observers with different filters.
+     * @tc.steps: step2. insert events without the mapping records, query and take the events of the observers.
+     * @tc.steps: step3. delete the events, check the events behind the min cursor are reclaimed.
+     */
+    AppEventStore::GetInstance().SetStorageMode(EventStorageMode::CURSOR);
+    ASSERT_EQ(AppEventStore::GetInstance().InitDbStore(), DB_SUCC);
+    std::vector<std::shared_ptr<AppEventPack>> events = { CreateAppEventPack() };
+    ASSERT_EQ(AppEventStore::GetInstance().InsertEvents(events), DB_SUCC);
+
+    const std::string otherName = "test_name_other";
+    int64_t observerSeq1 = AppEventStore::GetInstance().InsertObserver(Observer(TEST_OBSERVER_NAME, 0));
+    ASSERT_GT(observerSeq1, 0);
+    AppEventStore::GetInstance().SetEventFilter(observerSeq1, [](std::shared_ptr<AppEventPack> event) {
+        return true;
+    });
+    int64_t observerSeq2 = AppEventStore::GetInstance().InsertObserver(Observer(TEST_OBSERVER_NAME, 1));
+    ASSERT_GT(observerSeq2, 0);
+    AppEventStore::GetInstance().SetEventFilter(observerSeq2, [otherName](std::shared_ptr<AppEventPack> event) {
+        return event->GetName() == otherName;
+    });
+
+    // the events written before the observers are added are not pending for them
+    events.clear();
+    for (int i = 0; i < 4; ++i) { // 4 events, the names of the odd ones are otherName
+        std::string name = (i % 2 == 0) ? TEST_EVENT_NAME : otherName;
+        events.emplace_back(std::make_shared<AppEventPack>(TEST_EVENT_DOMAIN, name, TEST_EVENT_TYPE));
+    }
+    ASSERT_EQ(AppEventStore::GetInstance().InsertEvents(events), DB_SUCC);
+    std::vector<std::shared_ptr<AppEventPack>> queryEvents;
+    ASSERT_EQ(AppEventStore::GetInstance().QueryEvents(queryEvents, observerSeq1), DB_SUCC);
+    ASSERT_EQ(queryEvents.size(), events.size());
+    // the events are queried in ascending order of seq
+    ASSERT_EQ(queryEvents[0]->GetSeq(), events[0]->GetSeq());
+    queryEvents.clear();
+    ASSERT_EQ(AppEventStore::GetInstance().QueryEvents(queryEvents, observerSeq2, 1), DB_SUCC);
+    ASSERT_EQ(queryEvents.size(), 1);
+    ASSERT_EQ(queryEvents[0]->GetSeq(), events[1]->GetSeq());
+
+    queryEvents.clear();
+    ASSERT_EQ(AppEventStore::GetInstance().TakeEvents(queryEvents, observerSeq1, 2), DB_SUCC); // take 2 events
+    ASSERT_EQ(queryEvents.size(), 2);
+    ASSERT_TRUE(AppEventStore::GetInstance().DeleteData(observerSeq2, {events[1]->GetSeq()}));
+    queryEvents.clear();
+    ASSERT_EQ(AppEventStore::GetInstance().QueryEvents(queryEvents, observerSeq1), DB_SUCC);
+    ASSERT_EQ(queryEvents.size(), 2);
+    ASSERT_EQ(queryEvents[0]->GetSeq(), events[2]->GetSeq());
+    queryEvents.clear();
+    ASSERT_EQ(AppEventStore::GetInstance().QueryEvents(queryEvents, observerSeq2), DB_SUCC);
+    ASSERT_EQ(queryEvents.size(), 1);
+    ASSERT_EQ(queryEvents[0]->GetSeq(), events[3]->GetSeq());
+
+    // only the events after both cursors are kept
+    int ret = OHOS::NativeRdb::E_OK;
+    OHOS::NativeRdb::RdbStoreConfig config(TEST_DB_PATH);
+    config.SetSecurityLevel(OHOS::NativeRdb::SecurityLevel::S1);
+    AppEventStoreCallback callback;
+    auto store = OHOS::NativeRdb::RdbHelper::GetRdbStore(config, 7, callback, ret); // 7 means the db version
+    ASSERT_NE(store, nullptr);
+    auto resultSet = store->QuerySql(std::string("SELECT COUNT(*) FROM ") + Events::TABLE);
+    ASSERT_NE(resultSet, nullptr);
+    int eventNum = 0;
+    ASSERT_EQ(resultSet->GoToNextRow(), OHOS::NativeRdb::E_OK);
+    ASSERT_EQ(resultSet->GetInt(0, eventNum), OHOS::NativeRdb::E_OK);
+    resultSet->Close();
+    ASSERT_EQ(eventNum, 2); // 2 means the last two events
+
+    AppEventStore::GetInstance().SetStorageMode(EventStorageMode::MAPPING);
+    ASSERT_EQ(AppEventStore::GetInstance().DestroyDbStore(), DB_SUCC);
+}
+
+/**
+ * @tc.name: HiAppEventDBTest010
+ * @tc.desc: check the concurrent writing and querying of the events.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventDBTest010, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. write the events of an observer in several threads, query the events at the same time.
+     * @tc.steps: step2. check all the operations succeed and no event is lost.
+     */
+    ASSERT_EQ(AppEventStore::GetInstance().InitDbStore(), DB_SUCC);
+    int64_t observerSeq = AppEventStore::GetInstance().InsertObserver(Observer(TEST_OBSERVER_NAME, 0));
+    ASSERT_GT(observerSeq, 0);
+    constexpr int threadNum = 4;
+    constexpr int batchNum = 10;
+    constexpr int batchSize = 10;
+    std::atomic<int> failedNum = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadNum; ++i) {
+        threads.emplace_back([observerSeq, &failedNum] {
+            for (int j = 0; j < batchNum; ++j) {
+                std::vector<std::shared_ptr<AppEventPack>> events(batchSize, nullptr);
+                std::generate(events.begin(), events.end(), CreateAppEventPack);
+                std::vector<std::vector<int64_t>> observerSeqs(batchSize, {observerSeq});
+                if (AppEventStore::GetInstance().InsertEvents(events, observerSeqs) != DB_SUCC) {
+                    ++failedNum;
+                }
+            }
+        });
+        threads.emplace_back([observerSeq, &failedNum] {
+            for (int j = 0; j < batchNum; ++j) {
+                std::vector<std::shared_ptr<AppEventPack>> events;
+                if (AppEventStore::GetInstance().QueryEvents(events, observerSeq) != DB_SUCC) {
+                    ++failedNum;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(failedNum, 0);
+    std::vector<std::shared_ptr<AppEventPack>> events;
+    ASSERT_EQ(AppEventStore::GetInstance().QueryEvents(events, observerSeq), DB_SUCC);
+    ASSERT_EQ(events.size(), threadNum * batchNum * batchSize);
+    ASSERT_EQ(AppEventStore::GetInstance().DestroyDbStore(), DB_SUCC);
+}
+
+/**
+ * @tc.name: HiAppEventDBTest011
+ * @tc.desc: check the events read from the bound statements of the events.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventDBTest011, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. insert the events of an observer.
+     * @tc.steps: step2. query the events with and without the limit, check the fields of the events.
+     */
+    ASSERT_EQ(AppEventStore::GetInstance().InitDbStore(), DB_SUCC);
+    int64_t observerSeq = AppEventStore::GetInstance().InsertObserver(Observer(TEST_OBSERVER_NAME, 0));
+    ASSERT_GT(observerSeq, 0);
+    auto event = CreateAppEventPack();
+    event->SetTimeZone("+0800");
+    event->SetPid(1); // 1 means test pid
+    event->SetTid(2); // 2 means test tid
+    event->SetTraceId(3); // 3 means test trace id
+    event->SetSpanId(4); // 4 means test span id
+    event->SetPspanId(5); // 5 means test parent span id
+    event->SetTraceFlag(6); // 6 means test trace flag
+    event->SetRunningId(TEST_RUNNING_ID);
+    std::vector<std::shared_ptr<AppEventPack>> events = { event, CreateAppEventPack() };
+    ASSERT_EQ(AppEventStore::GetInstance().InsertEvents(events, {{observerSeq}, {observerSeq}}), DB_SUCC);
+
+    std::vector<std::shared_ptr<AppEventPack>> queryEvents;
+    ASSERT_EQ(AppEventStore::GetInstance().QueryEvents(queryEvents, observerSeq), DB_SUCC);
+    ASSERT_EQ(queryEvents.size(), events.size());
+    // the events are queried in descending order of seq
+    auto queryEvent = queryEvents.back();
+    ASSERT_EQ(queryEvent->GetSeq(), event->GetSeq());
+    ASSERT_EQ(queryEvent->GetDomain(), event->GetDomain());
+    ASSERT_EQ(queryEvent->GetName(), event->GetName());
+    ASSERT_EQ(queryEvent->GetType(), event->GetType());
+    ASSERT_EQ(queryEvent->GetTime(), event->GetTime());
+    ASSERT_EQ(queryEvent->GetTimeZone(), event->GetTimeZone());
+    ASSERT_EQ(queryEvent->GetPid(), event->GetPid());
+    ASSERT_EQ(queryEvent->GetTid(), event->GetTid());
+    ASSERT_EQ(queryEvent->GetTraceId(), event->GetTraceId());
+    ASSERT_EQ(queryEvent->GetSpanId(), event->GetSpanId());
+    ASSERT_EQ(queryEvent->GetPspanId(), event->GetPspanId());
+    ASSERT_EQ(queryEvent->GetTraceFlag(), event->GetTraceFlag());
+    ASSERT_EQ(queryEvent->GetParamStr(), event->GetParamStr());
+    ASSERT_EQ(queryEvent->GetRunningId(), event->GetRunningId());
+
+    queryEvents.clear();
+    ASSERT_EQ(AppEventStore::GetInstance().QueryEvents(queryEvents, observerSeq, 1), DB_SUCC);
+    ASSERT_EQ(queryEvents.size(), 1);
+    ASSERT_EQ(queryEvents[0]->GetSeq(), events[1]->GetSeq());
+    ASSERT_EQ(AppEventStore::GetInstance().DestroyDbStore(), DB_SUCC);
+}
+
+/**
+ * @tc.name: HiAppEventDBTest012
+ * @tc.desc: check the events queried by the total size.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventDBTest012, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. insert the events of an observer.
+     * @tc.steps: step2. query the events by the total size, check only the events within the size are read.
+     */
+    ASSERT_EQ(AppEventStore::GetInstance().InitDbStore(), DB_SUCC);
+    int64_t observerSeq = AppEventStore::GetInstance().InsertObserver(Observer(TEST_OBSERVER_NAME, 0));
+    ASSERT_GT(observerSeq, 0);
+    std::vector<std::shared_ptr<AppEventPack>> events = {
+        CreateAppEventPack(), CreateAppEventPack(), CreateAppEventPack()
+    };
+    ASSERT_EQ(AppEventStore::GetInstance().InsertEvents(events, {{observerSeq}, {observerSeq}, {observerSeq}}),
+        DB_SUCC);
+
+    std::vector<std::shared_ptr<AppEventPack>> queryEvents;
+    ASSERT_EQ(AppEventStore::GetInstance().QueryEventsBySize(queryEvents, observerSeq, 1), DB_SUCC);
+    ASSERT_TRUE(queryEvents.empty());
+    ASSERT_EQ(AppEventStore::GetInstance().QueryEventsBySize(queryEvents, observerSeq, 0), DB_SUCC);
+    ASSERT_TRUE(queryEvents.empty());
+
+    ASSERT_EQ(AppEventStore::GetInstance().QueryEvents(queryEvents, observerSeq, 1), DB_SUCC);
+    ASSERT_EQ(queryEvents.size(), 1);
+    size_t eventSize = queryEvents[0]->GetEventSize();
+    queryEvents.clear();
+    ASSERT_EQ(AppEventStore::GetInstance().QueryEventsBySize(queryEvents, observerSeq, eventSize * 2 + 1), DB_SUCC);
+    ASSERT_EQ(queryEvents.size(), 2); // 2 means the number of the events within the size
+    queryEvents.clear();
+    ASSERT_EQ(AppEventStore::GetInstance().QueryEventsBySize(queryEvents, observerSeq, eventSize * 10), DB_SUCC);
+    ASSERT_EQ(queryEvents.size(), events.size());
+    ASSERT_EQ(AppEventStore::GetInstance().DestroyDbStore(), DB_SUCC);
+}
+
+/**
+ * @tc.name: HiAppEventDBTest013
+ * @tc.desc: check the number and the size of the pending events of the observer.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventDBTest013, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. insert the events of an observer.
+     * @tc.steps: step2. check the number and the size of the pending events are the same as the events.
+     */
+    ASSERT_EQ(AppEventStore::GetInstance().InitDbStore(), DB_SUCC);
+    int64_t observerSeq = AppEventStore::GetInstance().InsertObserver(Observer(TEST_OBSERVER_NAME, 0));
+    ASSERT_GT(observerSeq, 0);
+    int64_t row = 0;
+    int64_t size = 0;
+    ASSERT_EQ(AppEventStore::GetInstance().QueryPendingEvents(observerSeq, row, size), DB_SUCC);
+    ASSERT_EQ(row, 0);
+    ASSERT_EQ(size, 0);
+
+    std::vector<std::shared_ptr<AppEventPack>> events = { CreateAppEventPack(), CreateAppEventPack() };
+    ASSERT_EQ(AppEventStore::GetInstance().InsertEvents(events, {{observerSeq}, {observerSeq}}), DB_SUCC);
+    ASSERT_EQ(AppEventStore::GetInstance().QueryPendingEvents(observerSeq, row, size), DB_SUCC);
+    ASSERT_EQ(row, static_cast<int64_t>(events.size()));
+    ASSERT_EQ(size, static_cast<int64_t>(events[0]->GetEventSize() + events[1]->GetEventSize()));
+
+    ASSERT_TRUE(AppEventStore::GetInstance().DeleteData(observerSeq, {events[0]->GetSeq()}));
+    ASSERT_EQ(AppEventStore::GetInstance().QueryPendingEvents(observerSeq, row, size), DB_SUCC);
+    ASSERT_EQ(row, 1);
+    ASSERT_EQ(size, static_cast<int64_t>(events[1]->GetEventSize()));
+    ASSERT_EQ(AppEventStore::GetInstance().DestroyDbStore(), DB_SUCC);
+}
+
+/**
+ * @tc.name: HiAppEventDBTest014
+ * @tc.desc: check querying the events of the observer uses the index of the mapping table.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventDBTest014, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. open the db.
+     * @tc.steps: step2. explain the query plan of querying the events of the observer.
+     * @tc.steps: step3. check the plan searches the mapping table by idx_mapping_observer_event.
+     */
+    ASSERT_EQ(AppEventStore::GetInstance().InitDbStore(), DB_SUCC);
+    int ret = OHOS::NativeRdb::E_OK;
+    OHOS::NativeRdb::RdbStoreConfig config(TEST_DB_PATH);
+    config.SetSecurityLevel(OHOS::NativeRdb::SecurityLevel::S1);
+    AppEventStoreCallback callback;
+    auto store = OHOS::NativeRdb::RdbHelper::GetRdbStore(config, 7, callback, ret); // 7 means the db version
+    ASSERT_NE(store, nullptr);
+    constexpr int64_t observerSeq = 1;
+    constexpr int64_t takeSize = 100;
+    auto resultSet = store->QuerySql("EXPLAIN QUERY PLAN " + AppEventStatement::QueryEventsOfObserver(),
+        std::vector<OHOS::NativeRdb::ValueObject>{observerSeq, takeSize});
+    ASSERT_NE(resultSet, nullptr);
+    std::string plan;
+    while (resultSet->GoToNextRow() == OHOS::NativeRdb::E_OK) {
+        std::string detail;
+        resultSet->GetString(3, detail); // 3 means the index of the detail column of the plan
+        plan += detail + ";";
+    }
+    resultSet->Close();
+    ASSERT_NE(plan.find("idx_mapping_observer_event"), std::string::npos) << plan;
+    ASSERT_EQ(AppEventStore::GetInstance().DestroyDbStore(), DB_SUCC);
+}
+
+/**
+ * @tc.name: HiAppEventDBTest015
+ * @tc.desc: check the events acked out of order in EventStorageMode::CURSOR.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventDBTest015, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. open the db in EventStorageMode::CURSOR, add an observer and insert 4 events.
+     * @tc.steps: step2. ack the last two events before the first two, as the concurrent reports complete.
+     * @tc.steps: step3. check the events before the acked ones are still pending, and the acked ones are not.
+     */
+    AppEventStore::GetInstance().SetStorageMode(EventStorageMode::CURSOR);
+    ASSERT_EQ(AppEventStore::GetInstance().InitDbStore(), DB_SUCC);
+    int64_t observerSeq = AppEventStore::GetInstance().InsertObserver(Observer(TEST_OBSERVER_NAME, 0));
+    ASSERT_GT(observerSeq, 0);
+    AppEventStore::GetInstance().SetEventFilter(observerSeq, [](std::shared_ptr<AppEventPack> event) {
+        return true;
+    });
+    std::vector<std::shared_ptr<AppEventPack>> events(4, nullptr); // 4 means the number of the events
+    std::generate(events.begin(), events.end(), CreateAppEventPack);
+    ASSERT_EQ(AppEventStore::GetInstance().InsertEvents(events), DB_SUCC);
+
+    ASSERT_TRUE(AppEventStore::GetInstance().DeleteData(observerSeq, {events[3]->GetSeq()}));
+    ASSERT_TRUE(AppEventStore::GetInstance().DeleteData(observerSeq, {events[1]->GetSeq()}));
+    std::vector<std::shared_ptr<AppEventPack>> queryEvents;
+    ASSERT_EQ(AppEventStore::GetInstance().QueryEvents(queryEvents, observerSeq), DB_SUCC);
+    ASSERT_EQ(queryEvents.size(), 2);
+    ASSERT_EQ(queryEvents[0]->GetSeq(), events[0]->GetSeq());
+    ASSERT_EQ(queryEvents[1]->GetSeq(), events[2]->GetSeq());
+    int64_t row = 0;
+    int64_t size = 0;
+    ASSERT_EQ(AppEventStore::GetInstance().QueryPendingEvents(observerSeq, row, size), DB_SUCC);
+    ASSERT_EQ(row, 2);
+
+    // the cursor moves over the first two events, then the event acked out of order is still not pending
+    ASSERT_TRUE(AppEventStore::GetInstance().DeleteData(observerSeq, {events[0]->GetSeq()}));
+    queryEvents.clear();
+    ASSERT_EQ(AppEventStore::GetInstance().QueryEvents(queryEvents, observerSeq), DB_SUCC);
+    ASSERT_EQ(queryEvents.size(), 1);
+    ASSERT_EQ(queryEvents[0]->GetSeq(), events[2]->GetSeq());
+
+    ASSERT_TRUE(AppEventStore::GetInstance().DeleteData(observerSeq, {events[2]->GetSeq()}));
+    queryEvents.clear();
+    ASSERT_EQ(AppEventStore::GetInstance().QueryEvents(queryEvents, observerSeq), DB_SUCC);
+    ASSERT_TRUE(queryEvents.empty());
+
+    AppEventStore::GetInstance().SetStorageMode(EventStorageMode::MAPPING);
+    ASSERT_EQ(AppEventStore::GetInstance().DestroyDbStore(), DB_SUCC);
+}
+
+/**
+ * @tc.name: HiAppEventDBTest016
+ * @tc.desc: check the stored size of the event contains its custom params.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventDBTest016, TestSize.Level0)
+{
+    /**
+     * @tc.steps: step1. insert the custom params and an event of an observer.
+     * @tc.steps: step2. check the size of the pending events is the size of the event with the custom params.
+     */
+    ASSERT_EQ(AppEventStore::GetInstance().InitDbStore(), DB_SUCC);
+    auto eventParams = CreateAppEventPack();
+    eventParams->SetRunningId(TEST_RUNNING_ID);
+    eventParams->AddParam("custom_data", "value_str");
+    ASSERT_EQ(AppEventStore::GetInstance().InsertCustomEventParams(eventParams), DB_SUCC);
+    int64_t observerSeq = AppEventStore::GetInstance().InsertObserver(Observer(TEST_OBSERVER_NAME, 0));
+    ASSERT_GT(observerSeq, 0);
+
+    auto event = CreateAppEventPack();
+    event->SetRunningId(TEST_RUNNING_ID);
+    std::vector<std::shared_ptr<AppEventPack>> events = { event };
+    ASSERT_EQ(AppEventStore::GetInstance().InsertEvents(events, {{observerSeq}}), DB_SUCC);
+    ASSERT_EQ(AppEventStore::GetInstance().QueryCustomParamsAdd2EventPack(event), DB_SUCC);
+    int64_t row = 0;
+    int64_t size = 0;
+    ASSERT_EQ(AppEventStore::GetInstance().QueryPendingEvents(observerSeq, row, size), DB_SUCC);
+    ASSERT_EQ(row, 1);
+    ASSERT_EQ(size, static_cast<int64_t>(event->GetEventSize()));
+    ASSERT_EQ(AppEventStore::GetInstance().DestroyDbStore(), DB_SUCC);
+}
+
+/**
+ * @tc.name: HiAppEventWriteTest001
+ * @tc.desc: check the result of writing events in batches.
+ * @tc.type: FUNC
+ * @tc.require: issueI5NTOS
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventWriteTest001, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. set the invalid and valid batch config.
+     * @tc.steps: step2. write the events by one batch.
+     * @tc.steps: step3. submit the events to the writing queue.
+     */
+    WriteBatchConfig defaultConfig = GetWriteBatchConfig();
+    SetWriteBatchConfig({ .maxCount = 0, .maxLatencyMs = 0 });
+    ASSERT_EQ(GetWriteBatchConfig().maxCount, defaultConfig.maxCount);
+    SetWriteBatchConfig({ .maxCount = 2, .maxLatencyMs = 10 });
+    ASSERT_EQ(GetWriteBatchConfig().maxCount, 2);
+    ASSERT_EQ(GetWriteBatchConfig().maxLatencyMs, 10);
+
+    uint64_t oldSize = FileUtil::GetDirSize(TEST_DIR);
+    std::vector<std::shared_ptr<AppEventPack>> events = { CreateAppEventPack(), CreateAppEventPack() };
+    WriteEvents(events);
+    uint64_t batchSize = events[0]->GetEventStr().size() + events[1]->GetEventStr().size();
+    ASSERT_EQ(FileUtil::GetDirSize(TEST_DIR), oldSize + batchSize);
+
+    oldSize = FileUtil::GetDirSize(TEST_DIR);
+    constexpr int eventNum = 5;
+    for (int i = 0; i < eventNum; ++i) {
+        SubmitWritingTask(CreateAppEventPack(), "test_batch");
+    }
+    // wait until all the batches are written, at most 1s
+    uint64_t expectedSize = oldSize + eventNum * events[0]->GetEventStr().size();
+    uint64_t deadline = TimeUtil::GetMilliseconds() + 1000;
+    while (FileUtil::GetDirSize(TEST_DIR) < expectedSize && TimeUtil::GetMilliseconds() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10)); // 10ms
+    }
+    ASSERT_GE(FileUtil::GetDirSize(TEST_DIR), expectedSize);
+    SetWriteBatchConfig(defaultConfig);
+}
+
 /**
  * @tc.name: HiAppEventCleanTest001
  * @tc.desc: test the DB cleaner operation.
@@ -411,6 +935,71 @@ HWTEST_F(HiAppEventCacheTest, HiAppEventCleanTest003, TestSize.Level1)
     EXPECT_FALSE(OHOS::HiviewDFX::HiAppEventClean::IsStorageSpaceFull("", 0));
 }
 
+/**
+ * @tc.name: HiAppEventCleanTest004
+ * @tc.desc: test the storage size is accounted by the written size without scanning the dir.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventCleanTest004, TestSize.Level1)
+{
+    HiAppEventConfig::GetInstance().SetStorageDir(TEST_DIR);
+    uint64_t curSize = HiAppEventClean::GetStorageSize();
+    constexpr uint64_t writeSize = 100;
+    HiAppEventClean::AddStorageSize(writeSize);
+    EXPECT_EQ(HiAppEventClean::GetStorageSize(), curSize + writeSize);
+
+    // the size is seeded again by scanning the dir after the data is cleared
+    HiAppEventClean::ClearData(TEST_DIR);
+    EXPECT_EQ(HiAppEventClean::GetStorageSize(), FileUtil::GetDirSize(TEST_DIR) +
+        FileUtil::GetFileSize(TEST_DB_PATH) + FileUtil::GetFileSize(TEST_DB_PATH + "-wal") +
+        FileUtil::GetFileSize(TEST_DB_PATH + "-shm"));
+}
+
+/**
+ * @tc.name: HiAppEventCleanTest005
+ * @tc.desc: test the size of the db files contains the write-ahead log of the db.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventCleanTest005, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. insert events into the db.
+     * @tc.steps: step2. check the size of the db files is the sum of the db file, the -wal file and the -shm file.
+     */
+    ASSERT_EQ(AppEventStore::GetInstance().InitDbStore(), DB_SUCC);
+    int64_t observerSeq = AppEventStore::GetInstance().InsertObserver(Observer(TEST_OBSERVER_NAME, 0));
+    ASSERT_GT(observerSeq, 0);
+    std::vector<std::shared_ptr<AppEventPack>> events = { CreateAppEventPack() };
+    ASSERT_EQ(AppEventStore::GetInstance().InsertEvents(events, {{observerSeq}}), DB_SUCC);
+
+    uint64_t walSize = FileUtil::GetFileSize(TEST_DB_PATH + "-wal");
+    uint64_t shmSize = FileUtil::GetFileSize(TEST_DB_PATH + "-shm");
+    EXPECT_EQ(AppEventDbCleaner(TEST_DIR).GetFilesSize(), FileUtil::GetFileSize(TEST_DB_PATH) + walSize + shmSize);
+    ASSERT_EQ(AppEventStore::GetInstance().DestroyDbStore(), DB_SUCC);
+}
+
+/**
+ * @tc.name: HiAppEventCleanTest006
+ * @tc.desc: test the write-ahead log of the db is truncated after the history events are deleted.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventCleanTest006, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. insert events into the db.
+     * @tc.steps: step2. delete the history events, check the -wal file is truncated.
+     */
+    ASSERT_EQ(AppEventStore::GetInstance().InitDbStore(), DB_SUCC);
+    std::vector<std::shared_ptr<AppEventPack>> events(100, nullptr); // 100 means the number of the events
+    std::generate(events.begin(), events.end(), CreateAppEventPack);
+    ASSERT_EQ(AppEventStore::GetInstance().InsertEvents(events), DB_SUCC);
+    ASSERT_GT(FileUtil::GetFileSize(TEST_DB_PATH + "-wal"), 0);
+
+    ASSERT_EQ(AppEventStore::GetInstance().DeleteHistoryEvent(0, 0), DB_SUCC);
+    EXPECT_EQ(FileUtil::GetFileSize(TEST_DB_PATH + "-wal"), 0);
+    ASSERT_EQ(AppEventStore::GetInstance().DestroyDbStore(), DB_SUCC);
+}
+
 /**
  * @tc.name: HiAppEventStat001
  * @tc.desc: test the WriteApiEndEventAsync func of app event stat.
@@ -464,6 +1053,29 @@ HWTEST_F(HiAppEventCacheTest, SetConfigurationItem001, TestSize.Level1)
     EXPECT_TRUE(ret);
 }
 
+/**
+ * @tc.name: SetConfigurationItem002
+ * @tc.desc: test the config is read while it is changed by another thread.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, SetConfigurationItem002, TestSize.Level1)
+{
+    constexpr int loopTimes = 1000;
+    HiAppEventConfig::GetInstance().SetStorageDir(TEST_DIR);
+    std::thread writer([]() {
+        for (int i = 0; i < loopTimes; ++i) {
+            HiAppEventConfig::GetInstance().SetConfigurationItem("max_storage", std::to_string(i + 1) + "M");
+        }
+    });
+    for (int i = 0; i < loopTimes; ++i) {
+        EXPECT_EQ(HiAppEventConfig::GetInstance().GetStorageDir(), TEST_DIR);
+        EXPECT_GT(HiAppEventConfig::GetInstance().GetMaxStorageSize(), 0);
+    }
+    writer.join();
+    EXPECT_EQ(HiAppEventConfig::GetInstance().GetMaxStorageSize(), loopTimes * 1024 * 1024); // 1024: 1M = 1024K
+    EXPECT_TRUE(HiAppEventConfig::GetInstance().SetConfigurationItem("max_storage", "10M"));
+}
+
 /**
  * @tc.name: HiAppEventDbOnUpgrade001
  * @tc.desc: test the OnUpgrade func of class AppEventStoreCallback.
@@ -474,7 +1086,7 @@ HWTEST_F(HiAppEventCacheTest, HiAppEventDbOnUpgrade001, TestSize.Level1)
 {
     int ret = OHOS::NativeRdb::E_OK;
     const int oldVersion = 1;
-    const int dbVersion = 3;
+    const int dbVersion = 7;
     HiAppEventConfig::GetInstance().SetStorageDir(TEST_DIR);
     AppEventStore::GetInstance().InitDbStore();
     OHOS::NativeRdb::RdbStoreConfig config(TEST_DB_PATH);
@@ -483,29 +1095,148 @@ HWTEST_F(HiAppEventCacheTest, HiAppEventDbOnUpgrade001, TestSize.Level1)
     auto store = OHOS::NativeRdb::RdbHelper::GetRdbStore(config, dbVersion, callback, ret);
     // Only test upgrade DB from version 1 to 2, or from 2 to 3 in unit test.
     EXPECT_NE(callback.OnUpgrade(*store, oldVersion, oldVersion + 1), OHOS::NativeRdb::E_OK);
-    EXPECT_NE(callback.OnUpgrade(*store, oldVersion + 1, dbVersion), OHOS::NativeRdb::E_OK);
+    EXPECT_NE(callback.OnUpgrade(*store, oldVersion + 1, oldVersion + 2), OHOS::NativeRdb::E_OK);
+    // the indexes of version 4 are created only if they do not exist
+    EXPECT_EQ(callback.OnUpgrade(*store, oldVersion + 2, oldVersion + 3), OHOS::NativeRdb::E_OK);
+    // the cursor column of version 5 and the size column of version 6 already exist
+    EXPECT_NE(callback.OnUpgrade(*store, dbVersion - 3, dbVersion - 2), OHOS::NativeRdb::E_OK);
+    EXPECT_NE(callback.OnUpgrade(*store, dbVersion - 2, dbVersion - 1), OHOS::NativeRdb::E_OK);
+    // the api_stats table of version 7 is created again
+    EXPECT_EQ(callback.OnUpgrade(*store, dbVersion - 1, dbVersion), OHOS::NativeRdb::E_OK);
     EXPECT_EQ(callback.OnUpgrade(*store, dbVersion, dbVersion + 1), OHOS::NativeRdb::E_OK);
 
     ret = AppEventStore::GetInstance().DestroyDbStore();
     EXPECT_EQ(ret, DB_SUCC);
 }
 
+/**
+ * @tc.name: HiAppEventDbOnUpgrade002
+ * @tc.desc: check the api stats of version 6 are migrated when the db is upgraded to version 7.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventDbOnUpgrade002, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. create the api_stats table of version 6 and insert the metrics as json.
+     * @tc.steps: step2. upgrade the db from version 6 to 7.
+     * @tc.steps: step3. check the valid metrics are kept in the typed columns.
+     */
+    int ret = OHOS::NativeRdb::E_OK;
+    const int dbVersion = 7;
+    HiAppEventConfig::GetInstance().SetStorageDir(TEST_DIR);
+    AppEventStore::GetInstance().InitDbStore();
+    OHOS::NativeRdb::RdbStoreConfig config(TEST_DB_PATH);
+    config.SetSecurityLevel(OHOS::NativeRdb::SecurityLevel::S1);
+    AppEventStoreCallback callback;
+    auto store = OHOS::NativeRdb::RdbHelper::GetRdbStore(config, dbVersion, callback, ret);
+    ASSERT_NE(store, nullptr);
+    ASSERT_EQ(store->ExecuteSql("DROP TABLE api_stats"), OHOS::NativeRdb::E_OK);
+    ASSERT_EQ(store->ExecuteSql("CREATE TABLE api_stats(kit_name TEXT, api_name TEXT, metric TEXT)"),
+        OHOS::NativeRdb::E_OK);
+    const std::vector<std::string> metrics = {
+        R"({"errCode":0,"duration":100,"successful":true})",
+        R"({"errCode":401,"duration":50,"successful":false})",
+        R"({"errCode":0,"duration":-1,"successful":true})",
+        "invalid metric",
+    };
+    for (const auto& metric : metrics) {
+        ASSERT_EQ(store->ExecuteSql("INSERT INTO api_stats VALUES(?, ?, ?)", {
+            OHOS::NativeRdb::ValueObject(TEST_API_KIT), OHOS::NativeRdb::ValueObject(TEST_API_NAME),
+            OHOS::NativeRdb::ValueObject(metric)}), OHOS::NativeRdb::E_OK);
+    }
+
+    EXPECT_EQ(callback.OnUpgrade(*store, dbVersion - 1, dbVersion), OHOS::NativeRdb::E_OK);
+    std::vector<ApiStatsRecord> records;
+    EXPECT_EQ(ApiStatsDao::QueryAggregated(store, records), OHOS::NativeRdb::E_OK);
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0].kitName, TEST_API_KIT);
+    EXPECT_EQ(records[0].apiName, TEST_API_NAME);
+    EXPECT_EQ(records[0].callTimes, 2);
+    EXPECT_EQ(records[0].successTimes, 1);
+    EXPECT_EQ(records[0].maxCostTime, 100);
+    EXPECT_EQ(records[0].minCostTime, 50);
+    EXPECT_EQ(records[0].totalCostTime, 150);
+    EXPECT_EQ(records[0].errorCodes, "0:1,401:1");
+
+    ret = AppEventStore::GetInstance().DestroyDbStore();
+    EXPECT_EQ(ret, DB_SUCC);
+}
+
+/**
+ * @tc.name: HiAppEventDbOnUpgrade003
+ * @tc.desc: check the size of the events of version 5 contains the custom params after upgraded to version 6.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventCacheTest, HiAppEventDbOnUpgrade003, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. insert the custom params and an event of an observer.
+     * @tc.steps: step2. rebuild the events table of version 5 without the size column.
+     * @tc.steps: step3. upgrade the db from version 5 to 6.
+     * @tc.steps: step4. check the size of the upgraded event is the same as the size stored for the new event.
+     */
+    HiAppEventConfig::GetInstance().SetStorageDir(TEST_DIR);
+    ASSERT_EQ(AppEventStore::GetInstance().InitDbStore(), DB_SUCC);
+    auto eventParams = CreateAppEventPack();
+    eventParams->SetRunningId(TEST_RUNNING_ID);
+    eventParams->AddParam("custom_data", "value_str");
+    ASSERT_EQ(AppEventStore::GetInstance().InsertCustomEventParams(eventParams), DB_SUCC);
+    int64_t observerSeq = AppEventStore::GetInstance().InsertObserver(Observer(TEST_OBSERVER_NAME, 0));
+    ASSERT_GT(observerSeq, 0);
+    auto event = CreateAppEventPack();
+    event->SetRunningId(TEST_RUNNING_ID);
+    event->AddParam("int_key", 1);
+    std::vector<std::shared_ptr<AppEventPack>> events = { event };
+    ASSERT_EQ(AppEventStore::GetInstance().InsertEvents(events, {{observerSeq}}), DB_SUCC);
+    int64_t row = 0;
+    int64_t newSize = 0;
+    ASSERT_EQ(AppEventStore::GetInstance().QueryPendingEvents(observerSeq, row, newSize), DB_SUCC);
+    ASSERT_GT(newSize, static_cast<int64_t>(event->GetEventSize()));
+
+    int ret = OHOS::NativeRdb::E_OK;
+    const int dbVersion = 7;
+    OHOS::NativeRdb::RdbStoreConfig config(TEST_DB_PATH);
+    config.SetSecurityLevel(OHOS::NativeRdb::SecurityLevel::S1);
+    AppEventStoreCallback callback;
+    auto store = OHOS::NativeRdb::RdbHelper::GetRdbStore(config, dbVersion, callback, ret);
+    ASSERT_NE(store, nullptr);
+    const std::vector<std::string> sqls = {
+        "CREATE TABLE events_v5 AS SELECT seq, domain, name, type, time, tz, pid, tid, trace_id, span_id, pspan_id,"
+            " trace_flag, params, running_id FROM events",
+        "DROP TABLE events",
+        "ALTER TABLE events_v5 RENAME TO events",
+    };
+    for (const auto& sql : sqls) {
+        ASSERT_EQ(store->ExecuteSql(sql), OHOS::NativeRdb::E_OK);
+    }
+    EXPECT_EQ(callback.OnUpgrade(*store, dbVersion - 2, dbVersion - 1), OHOS::NativeRdb::E_OK);
+
+    int64_t size = 0;
+    ASSERT_EQ(AppEventStore::GetInstance().QueryPendingEvents(observerSeq, row, size), DB_SUCC);
+    ASSERT_EQ(row, 1);
+    EXPECT_EQ(size, newSize);
+    ASSERT_EQ(AppEventStore::GetInstance().DestroyDbStore(), DB_SUCC);
+}
+
 /**
  * @tc.name: AppEventStoreApiMetricTest001
- * @tc.desc: check the AppEventStore InsertApiMetricInfo function.
+ * @tc.desc: check the AppEventStore InsertApiStats function.
  * @tc.type: FUNC
  */
 HWTEST_F(HiAppEventCacheTest, AppEventStoreApiMetricTest001, TestSize.Level0)
 {
     /**
      * @tc.steps: step1. init db store.
-     * @tc.steps: step2. insert api metric info with valid params.
+     * @tc.steps: step2. insert api stats with valid params.
      * @tc.steps: step3. check insert result.
      */
     int result = AppEventStore::GetInstance().InitDbStore();
     ASSERT_EQ(result, DB_SUCC);
 
-    result = AppEventStore::GetInstance().InsertApiMetricInfo(TEST_API_KIT, TEST_API_NAME, TEST_METRIC_JSON);
+    result = AppEventStore::GetInstance().InsertApiStats({});
+    EXPECT_EQ(result, DB_SUCC);
+    auto record = CreateApiStatsRecord(TEST_API_KIT, TEST_API_NAME, 100, "0:1"); // 100 means the cost time
+    result = AppEventStore::GetInstance().InsertApiStats({record});
     EXPECT_EQ(result, OHOS::NativeRdb::E_OK);
 
     result = AppEventStore::GetInstance().DestroyDbStore();
@@ -514,30 +1245,44 @@ HWTEST_F(HiAppEventCacheTest, AppEventStoreApiMetricTest001, TestSize.Level0)
 
 /**
  * @tc.name: AppEventStoreApiMetricTest003
- * @tc.desc: check the AppEventStore QueryApiMetricInfoAll function.
+ * @tc.desc: check the AppEventStore QueryApiStats function.
  * @tc.type: FUNC
  */
 HWTEST_F(HiAppEventCacheTest, AppEventStoreApiMetricTest003, TestSize.Level0)
 {
     /**
-     * @tc.steps: step1. init db store and insert multiple records.
-     * @tc.steps: step2. query all api metric info.
-     * @tc.steps: step3. check query result.
+     * @tc.steps: step1. init db store and insert the records of two apis.
+     * @tc.steps: step2. query the api stats.
+     * @tc.steps: step3. check the records of each api are aggregated.
      */
     int result = AppEventStore::GetInstance().InitDbStore();
     ASSERT_EQ(result, DB_SUCC);
 
-    result = AppEventStore::GetInstance().InsertApiMetricInfo(TEST_API_KIT, TEST_API_NAME, TEST_METRIC_JSON);
+    result = AppEventStore::GetInstance().InsertApiStats({
+        CreateApiStatsRecord(TEST_API_KIT, TEST_API_NAME, 100, "0:1"),
+        CreateApiStatsRecord(TEST_API_KIT2, TEST_API_NAME2, 200, "1:1"),
+    });
     EXPECT_EQ(result, OHOS::NativeRdb::E_OK);
-    result = AppEventStore::GetInstance().InsertApiMetricInfo(TEST_API_KIT2, TEST_API_NAME2, TEST_METRIC_JSON2);
+    auto record = CreateApiStatsRecord(TEST_API_KIT, TEST_API_NAME, 50, "1:1"); // 50 means the cost time
+    result = AppEventStore::GetInstance().InsertApiStats({record});
     EXPECT_EQ(result, OHOS::NativeRdb::E_OK);
 
-    std::map<std::pair<std::string, std::string>, std::vector<std::string>> out;
-    result = AppEventStore::GetInstance().QueryApiMetricInfoAll(out);
+    std::vector<ApiStatsRecord> records;
+    result = AppEventStore::GetInstance().QueryApiStats(records);
     EXPECT_EQ(result, OHOS::NativeRdb::E_OK);
-    EXPECT_EQ(out.size(), 2);
-    EXPECT_EQ(out[std::make_pair(TEST_API_KIT, TEST_API_NAME)].size(), 1);
-    EXPECT_EQ(out[std::make_pair(TEST_API_KIT2, TEST_API_NAME2)].size(), 1);
+    ASSERT_EQ(records.size(), 2);
+    auto it = std::find_if(records.begin(), records.end(), [](const auto& record) {
+        return record.kitName == TEST_API_KIT && record.apiName == TEST_API_NAME;
+    });
+    ASSERT_TRUE(it != records.end());
+    EXPECT_EQ(it->callTimes, 2);
+    EXPECT_EQ(it->successTimes, 2);
+    EXPECT_EQ(it->maxCostTime, 100);
+    EXPECT_EQ(it->minCostTime, 50);
+    EXPECT_EQ(it->totalCostTime, 150);
+    // the error codes of the records are concatenated
+    EXPECT_NE(it->errorCodes.find("0:1"), std::string::npos);
+    EXPECT_NE(it->errorCodes.find("1:1"), std::string::npos);
 
     result = AppEventStore::GetInstance().DestroyDbStore();
     ASSERT_EQ(result, DB_SUCC);
@@ -545,29 +1290,30 @@ HWTEST_F(HiAppEventCacheTest, AppEventStoreApiMetricTest003, TestSize.Level0)
 
 /**
  * @tc.name: AppEventStoreApiMetricTest004
- * @tc.desc: check the AppEventStore ClearApiMetricInfo function.
+ * @tc.desc: check the AppEventStore ClearApiStats function.
  * @tc.type: FUNC
  */
 HWTEST_F(HiAppEventCacheTest, AppEventStoreApiMetricTest004, TestSize.Level0)
 {
     /**
      * @tc.steps: step1. init db store and insert data.
-     * @tc.steps: step2. clear api metric info.
+     * @tc.steps: step2. clear api stats.
      * @tc.steps: step3. verify data is cleared.
      */
     int result = AppEventStore::GetInstance().InitDbStore();
     ASSERT_EQ(result, DB_SUCC);
 
-    result = AppEventStore::GetInstance().InsertApiMetricInfo(TEST_API_KIT, TEST_API_NAME, TEST_METRIC_JSON);
+    auto record = CreateApiStatsRecord(TEST_API_KIT, TEST_API_NAME, 100, "0:1"); // 100 means the cost time
+    result = AppEventStore::GetInstance().InsertApiStats({record});
     EXPECT_EQ(result, OHOS::NativeRdb::E_OK);
 
-    result = AppEventStore::GetInstance().ClearApiMetricInfo();
+    result = AppEventStore::GetInstance().ClearApiStats();
     EXPECT_EQ(result, OHOS::NativeRdb::E_OK);
 
-    std::map<std::pair<std::string, std::string>, std::vector<std::string>> out;
-    result = AppEventStore::GetInstance().QueryApiMetricInfoAll(out);
+    std::vector<ApiStatsRecord> records;
+    result = AppEventStore::GetInstance().QueryApiStats(records);
     EXPECT_EQ(result, OHOS::NativeRdb::E_OK);
-    EXPECT_EQ(out.size(), 0);
+    EXPECT_EQ(records.size(), 0);
 
     result = AppEventStore::GetInstance().DestroyDbStore();
     ASSERT_EQ(result, DB_SUCC);
@@ -575,47 +1321,40 @@ HWTEST_F(HiAppEventCacheTest, AppEventStoreApiMetricTest004, TestSize.Level0)
 
 /**
  * @tc.name: AppEventStoreApiMetricTest005
- * @tc.desc: check the AppEventStore Insert+Query+Clear workflow.
+ * @tc.desc: check the AppEventStore TakeApiStats function.
  * @tc.type: FUNC
  */
 HWTEST_F(HiAppEventCacheTest, AppEventStoreApiMetricTest005, TestSize.Level0)
 {
     /**
      * @tc.steps: step1. init db store.
-     * @tc.steps: step2. insert multiple api metric records.
-     * @tc.steps: step3. query all and verify.
-     * @tc.steps: step4. clear and verify empty.
+     * @tc.steps: step2. insert multiple api stats records in one batch.
+     * @tc.steps: step3. take the api stats and verify the aggregated record.
+     * @tc.steps: step4. verify the records are deleted.
      */
     int result = AppEventStore::GetInstance().InitDbStore();
     ASSERT_EQ(result, DB_SUCC);
 
-    // Insert multiple records
+    std::vector<ApiStatsRecord> records;
     for (int i = 0; i < 5; i++) {
-        Json::Value metricObj(Json::objectValue);
-        metricObj["errCode"] = i;
-        metricObj["duration"] = 100 + i;
-        metricObj["successful"] = (i % 2 == 0);
-        std::string metricJson = Json::FastWriter().write(metricObj);
-        result = AppEventStore::GetInstance().InsertApiMetricInfo(TEST_API_KIT, TEST_API_NAME, metricJson);
-        EXPECT_EQ(result, OHOS::NativeRdb::E_OK);
+        records.emplace_back(CreateApiStatsRecord(TEST_API_KIT, TEST_API_NAME, 100 + i, std::to_string(i) + ":1"));
     }
-
-    // Query all
-    std::map<std::pair<std::string, std::string>, std::vector<std::string>> out;
-    result = AppEventStore::GetInstance().QueryApiMetricInfoAll(out);
+    result = AppEventStore::GetInstance().InsertApiStats(records);
     EXPECT_EQ(result, OHOS::NativeRdb::E_OK);
-    EXPECT_EQ(out.size(), 1);
-    EXPECT_EQ(out[std::make_pair(TEST_API_KIT, TEST_API_NAME)].size(), 5);
 
-    // Clear
-    result = AppEventStore::GetInstance().ClearApiMetricInfo();
+    records.clear();
+    result = AppEventStore::GetInstance().TakeApiStats(records);
     EXPECT_EQ(result, OHOS::NativeRdb::E_OK);
-
-    // Verify empty
-    out.clear();
-    result = AppEventStore::GetInstance().QueryApiMetricInfoAll(out);
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0].callTimes, 5);
+    EXPECT_EQ(records[0].maxCostTime, 104);
+    EXPECT_EQ(records[0].minCostTime, 100);
+    EXPECT_EQ(records[0].totalCostTime, 510);
+
+    records.clear();
+    result = AppEventStore::GetInstance().QueryApiStats(records);
     EXPECT_EQ(result, OHOS::NativeRdb::E_OK);
-    EXPECT_EQ(out.size(), 0);
+    EXPECT_EQ(records.size(), 0);
 
     result = AppEventStore::GetInstance().DestroyDbStore();
     ASSERT_EQ(result, DB_SUCC);
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "app_event_cache_common.h"
+#include "app_event_store.h"
+#include "hiappevent_base.h"
+#include "hiappevent_config.h"
+
+using namespace testing::ext;
+using namespace OHOS::HiviewDFX;
+using namespace OHOS::HiviewDFX::AppEventCacheCommon;
+
+namespace {
+const std::string TEST_DIR = "/data/test/hiappevent/";
+const std::string TEST_OBSERVER_NAME = "test_observer";
+constexpr size_t BATCH_SIZE = 1000;
+constexpr size_t OBSERVER_NUM = 4;
+constexpr uint32_t TAKE_SIZE = 100;
+constexpr int QUERY_TIMES = 20;
+
+// the cost of querying the latest events should not grow with the number of the stored events
+constexpr int64_t MAX_COST_RATIO = 5;
+constexpr int64_t COST_TOLERANCE_US = 10000;
+
+class HiAppEventDbBenchmarkTest : public testing::Test {
+public:
+    void SetUp()
+    {
+        HiAppEventConfig::GetInstance().SetStorageDir(TEST_DIR);
+    }
+    void TearDown() {}
+};
+
+std::shared_ptr<AppEventPack> CreateAppEventPack()
+{
+    return std::make_shared<AppEventPack>("benchmark_domain", "benchmark_name", 1);
+}
+}
+
+/**
+ * @tc.name: HiAppEventDBBenchmark001
+ * @tc.desc: check the latency of querying events when there are 10k and 100k stored events.
+ * @tc.type: PERF
+ */
+HWTEST_F(HiAppEventDbBenchmarkTest, HiAppEventDBBenchmark001, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. open the db.
+     * @tc.steps: step2. insert events mapped to several observers in batches.
+     * @tc.steps: step3. measure the cost of querying the latest events of an observer.
+     * @tc.steps: step4. check the cost with 100k events is close to the cost with 10k events.
+     */
+    const std::vector<size_t> totalNums = {10000, 100000};
+    ASSERT_EQ(AppEventStore::GetInstance().InitDbStore(), DB_SUCC);
+    std::vector<int64_t> observerSeqs;
+    for (size_t i = 0; i < OBSERVER_NUM; ++i) {
+        observerSeqs.emplace_back(AppEventStore::GetInstance().InsertObserver(
+            Observer(TEST_OBSERVER_NAME + std::to_string(i), 0, "")));
+        ASSERT_GT(observerSeqs.back(), 0);
+    }
+
+    size_t storedNum = 0;
+    std::vector<int64_t> costs;
+    for (auto totalNum : totalNums) {
+        while (storedNum < totalNum) {
+            std::vector<std::shared_ptr<AppEventPack>> events;
+            std::vector<std::vector<int64_t>> mappings;
+            for (size_t i = 0; i < BATCH_SIZE; ++i, ++storedNum) {
+                events.emplace_back(CreateAppEventPack());
+                mappings.push_back({observerSeqs[storedNum % OBSERVER_NUM]});
+            }
+            ASSERT_EQ(AppEventStore::GetInstance().InsertEvents(events, mappings), DB_SUCC);
+        }
+        auto beginTime = std::chrono::steady_clock::now();
+        for (int i = 0; i < QUERY_TIMES; ++i) {
+            std::vector<std::shared_ptr<AppEventPack>> events;
+            ASSERT_EQ(AppEventStore::GetInstance().QueryEvents(events, observerSeqs[0], TAKE_SIZE), DB_SUCC);
+            ASSERT_EQ(events.size(), TAKE_SIZE);
+        }
+        auto endTime = std::chrono::steady_clock::now();
+        costs.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(endTime - beginTime).count());
+        std::cout << "query " << TAKE_SIZE << " of " << totalNum << " events " << QUERY_TIMES << " times, cost="
+            << costs.back() << "us" << std::endl;
+    }
+    ASSERT_LE(costs.back(), costs.front() * MAX_COST_RATIO + COST_TOLERANCE_US);
+
+    ASSERT_EQ(AppEventStore::GetInstance().DestroyDbStore(), DB_SUCC);
+}
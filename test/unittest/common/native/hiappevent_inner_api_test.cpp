@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 
 #include "app_event_processor_mgr.h"
+#include "app_event_processor_proxy.h"
 #include "application_context.h"
 #include "hiappevent_base.h"
 #include "hiappevent_facade.h"
@@ -282,6 +283,98 @@ int AppEventProcessorTest::OnReport(
     return 0;
 }
 
+class AsyncProcessorTest : public AppEventAsyncProcessor {
+public:
+    int ValidateUserId(const UserId& userId) override
+    {
+        return 0;
+    }
+
+    int ValidateUserProperty(const UserProperty& userProperty) override
+    {
+        return 0;
+    }
+
+    int ValidateEvent(const AppEventInfo& event) override
+    {
+        return 0;
+    }
+
+    void OnReportAsync(
+        int64_t processorSeq,
+        const std::vector<UserId>& userIds,
+        const std::vector<UserProperty>& userProperties,
+        const std::vector<AppEventInfo>& events,
+        std::shared_ptr<ReportCompletion> completion) override
+    {
+        reportedNums_.emplace_back(events.size());
+        completions_.emplace_back(completion);
+    }
+
+    const std::vector<size_t>& GetReportedNums() const
+    {
+        return reportedNums_;
+    }
+
+    std::shared_ptr<ReportCompletion> TakeCompletion()
+    {
+        auto completion = completions_.front();
+        completions_.erase(completions_.begin());
+        return completion;
+    }
+
+private:
+    std::vector<size_t> reportedNums_;
+    std::vector<std::shared_ptr<ReportCompletion>> completions_;
+};
+
+class FailedProcessorTest : public AppEventProcessor {
+public:
+    int OnReport(
+        int64_t processorSeq,
+        const std::vector<UserId>& userIds,
+        const std::vector<UserProperty>& userProperties,
+        const std::vector<AppEventInfo>& events) override
+    {
+        reportedNums_.emplace_back(events.size());
+        return -1;
+    }
+
+    int ValidateUserId(const UserId& userId) override
+    {
+        return 0;
+    }
+
+    int ValidateUserProperty(const UserProperty& userProperty) override
+    {
+        return 0;
+    }
+
+    int ValidateEvent(const AppEventInfo& event) override
+    {
+        return 0;
+    }
+
+    const std::vector<size_t>& GetReportedNums() const
+    {
+        return reportedNums_;
+    }
+
+private:
+    std::vector<size_t> reportedNums_;
+};
+
+std::vector<std::shared_ptr<AppEventPack>> CreateEventsWithSeq(int64_t beginSeq, int64_t endSeq)
+{
+    std::vector<std::shared_ptr<AppEventPack>> events;
+    for (int64_t seq = beginSeq; seq < endSeq; ++seq) {
+        auto event = std::make_shared<AppEventPack>(TEST_EVENT_DOMAIN, TEST_EVENT_NAME, TEST_EVENT_TYPE);
+        event->SetSeq(seq);
+        events.emplace_back(event);
+    }
+    return events;
+}
+
 int AppEventProcessorTest::ValidateUserId(const UserId& userId)
 {
     return (userId.name.find("test") == std::string::npos) ? -1 : 0;
@@ -444,7 +537,7 @@ HWTEST_F(HiAppEventInnerApiTest, HiAppEventInnerApiTest006, TestSize.Level0)
     ASSERT_EQ(processor->GetReportTimes(), 0);
     WriteEventOnce();
     ASSERT_EQ(processor->GetReportTimes(), 0);
-    sleep(HiAppEvent::TIMEOUT_STEP + 1); // 31s
+    sleep(3); // 3s, the period is 2s
     ASSERT_EQ(processor->GetReportTimes(), 1);
 
     CheckUnregisterObserver(TEST_PROCESSOR_NAME);
@@ -955,6 +1048,8 @@ HWTEST_F(HiAppEventInnerApiTest, HiAppEventInnerApiTest024, TestSize.Level0)
 
     auto processor = std::make_shared<AppEventProcessorTest>();
     ASSERT_EQ(AppEventProcessorMgr::RegisterProcessor(TEST_PROCESSOR_NAME, processor), ERROR_NOT_APP);
+    ASSERT_EQ(AppEventProcessorMgr::RegisterAsyncProcessor(TEST_PROCESSOR_NAME,
+        std::make_shared<AsyncProcessorTest>()), ERROR_NOT_APP);
     ASSERT_EQ(AppEventProcessorMgr::UnregisterProcessor(TEST_PROCESSOR_NAME), ERROR_NOT_APP);
 
     std::vector<int64_t> processorSeqs;
@@ -1153,4 +1248,53 @@ HWTEST_F(HiAppEventInnerApiTest, HiAppEventInnerApiTest032, TestSize.Level1)
     };
     AppEventProcessorMgr::AddProcessorAsync(config, cb);
     sleep(1); // Ensure that the asynchronous task is executed.
-}
\ No newline at end of file
+}
+
+/**
+ * @tc.name: HiAppEventInnerApiTest033
+ * @tc.desc: test the in-flight events are not reported again by the asynchronous processor.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventInnerApiTest, HiAppEventInnerApiTest033, TestSize.Level1)
+{
+    auto processor = std::make_shared<AsyncProcessorTest>();
+    auto proxy = std::make_shared<AppEventProcessorProxy>(TEST_PROCESSOR_NAME, processor, processor);
+
+    proxy->OnEvents(CreateEventsWithSeq(1, 3)); // 3 means events of seq 1 and 2
+    proxy->OnEvents(CreateEventsWithSeq(1, 4)); // 4 means events of seq 1 to 3
+    ASSERT_EQ(processor->GetReportedNums(), std::vector<size_t>({2, 1}));
+
+    // the reports are deferred during the backoff after a failed report
+    processor->TakeCompletion()->Complete(0);
+    processor->TakeCompletion()->Complete(-1);
+    proxy->OnEvents(CreateEventsWithSeq(3, 5)); // 5 means events of seq 3 and 4
+    ASSERT_EQ(processor->GetReportedNums().size(), 2);
+}
+
+/**
+ * @tc.name: HiAppEventInnerApiTest034
+ * @tc.desc: test the synchronous processor reports the events again without backoff after a failed report.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventInnerApiTest, HiAppEventInnerApiTest034, TestSize.Level1)
+{
+    auto processor = std::make_shared<FailedProcessorTest>();
+    auto proxy = std::make_shared<AppEventProcessorProxy>(TEST_PROCESSOR_NAME, processor);
+
+    proxy->OnEvents(CreateEventsWithSeq(1, 3)); // 3 means events of seq 1 and 2
+    proxy->OnEvents(CreateEventsWithSeq(1, 4)); // 4 means events of seq 1 to 3
+    ASSERT_EQ(processor->GetReportedNums(), std::vector<size_t>({2, 3}));
+}
+
+/**
+ * @tc.name: HiAppEventInnerApiTest035
+ * @tc.desc: test registering the asynchronous processor.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventInnerApiTest, HiAppEventInnerApiTest035, TestSize.Level1)
+{
+    auto processor = std::make_shared<AsyncProcessorTest>();
+    ASSERT_EQ(AppEventProcessorMgr::RegisterAsyncProcessor(TEST_PROCESSOR_NAME, processor), 0);
+    ASSERT_EQ(AppEventProcessorMgr::RegisterAsyncProcessor(TEST_PROCESSOR_NAME, processor), -1);
+    ASSERT_EQ(AppEventProcessorMgr::UnregisterProcessor(TEST_PROCESSOR_NAME), 0);
+}
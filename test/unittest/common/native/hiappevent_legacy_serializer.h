@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIAPPEVENT_TEST_UNITTEST_COMMON_NATIVE_HIAPPEVENT_LEGACY_SERIALIZER_H
+#define HIAPPEVENT_TEST_UNITTEST_COMMON_NATIVE_HIAPPEVENT_LEGACY_SERIALIZER_H
+
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "hiappevent_base.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace LegacySerializer {
+template<typename T>
+struct IsVector : std::false_type {};
+
+template<typename T>
+struct IsVector<std::vector<T>> : std::true_type {};
+
+inline std::string TrimRightZero(const std::string& str)
+{
+    auto endIndex = str.find_last_not_of("0");
+    if (endIndex == std::string::npos) {
+        return str;
+    }
+    return (str[endIndex] == '.') ? str.substr(0, endIndex) : str.substr(0, endIndex + 1);
+}
+
+// the stringstream based serialization used before, as the baseline of the output and the cost
+template<typename T>
+std::string GetLegacyValueStr(const T& value)
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        return value ? "true" : "false";
+    } else if constexpr (std::is_same_v<T, char>) {
+        return "\"" + std::to_string(value) + "\"";
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return TrimRightZero(std::to_string(value));
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        return "\"" + value + "\"";
+    } else {
+        return std::to_string(value);
+    }
+}
+
+template<typename T>
+std::string GetLegacyValuesStr(const std::vector<T>& values)
+{
+    std::string valuesStr = "[";
+    for (size_t i = 0; i < values.size(); ++i) {
+        T value = values[i]; // vector<bool> is stored as bit type
+        valuesStr.append(GetLegacyValueStr(value)).append(i + 1 == values.size() ? "" : ",");
+    }
+    return valuesStr + "]";
+}
+
+inline std::string GetLegacyParamValueStr(const AppEventParamValue& value)
+{
+    return std::visit([](const auto& realValue) -> std::string {
+        using T = std::decay_t<decltype(realValue)>;
+        if constexpr (std::is_same_v<T, std::monostate>) {
+            return "";
+        } else if constexpr (IsVector<T>::value) {
+            return GetLegacyValuesStr(realValue);
+        } else {
+            return GetLegacyValueStr(realValue);
+        }
+    }, value);
+}
+
+inline void AddLegacyParams(std::stringstream& jsonStr,
+    const std::vector<std::pair<std::string, AppEventParamValue>>& params)
+{
+    if (params.empty()) {
+        return;
+    }
+    for (const auto& [name, value] : params) {
+        jsonStr << "\"" << name << "\":" << GetLegacyParamValueStr(value) << ",";
+    }
+    jsonStr.seekp(-1, std::ios_base::end); // -1 for delete ','
+}
+
+inline std::string GetLegacyParamStr(const std::vector<std::pair<std::string, AppEventParamValue>>& params)
+{
+    std::stringstream jsonStr;
+    jsonStr << "{";
+    AddLegacyParams(jsonStr, params);
+    jsonStr << "}" << std::endl;
+    return jsonStr.str();
+}
+
+inline std::string GetLegacyEventStr(const AppEventPack& event,
+    const std::vector<std::pair<std::string, AppEventParamValue>>& params)
+{
+    std::stringstream jsonStr;
+    jsonStr << "{";
+    jsonStr << "\"" << "domain_" << "\":" << "\"" << event.GetDomain() << "\",";
+    jsonStr << "\"" << "name_" << "\":" << "\"" << event.GetName() << "\",";
+    jsonStr << "\"" << "type_" << "\":" <<  event.GetType() << ",";
+    jsonStr << "\"" << "time_" << "\":" << std::to_string(event.GetTime()) << ",";
+    jsonStr << "\"tz_\":\"" << event.GetTimeZone() << "\",";
+    jsonStr << "\"" << "pid_" << "\":" << event.GetPid() << ",";
+    jsonStr << "\"" << "tid_" << "\":" << event.GetTid();
+    if (event.GetTraceId() != 0) {
+        jsonStr << "," << "\"" << "traceid_" << "\":" << event.GetTraceId();
+        jsonStr << "," << "\"" << "spanid_" << "\":" << event.GetSpanId();
+        jsonStr << "," << "\"" << "pspanid_" << "\":" << event.GetPspanId();
+        jsonStr << "," << "\"" << "trace_flag_" << "\":" << event.GetTraceFlag();
+    }
+    if (!params.empty()) {
+        jsonStr << ",";
+        AddLegacyParams(jsonStr, params);
+    }
+    jsonStr << "}" << std::endl;
+    return jsonStr.str();
+}
+} // namespace LegacySerializer
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIAPPEVENT_TEST_UNITTEST_COMMON_NATIVE_HIAPPEVENT_LEGACY_SERIALIZER_H
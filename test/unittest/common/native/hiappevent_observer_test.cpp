@@ -13,12 +13,19 @@
  * limitations under the License.
  */
 
+#include <atomic>
+#include <future>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "app_event.h"
+#include "app_event_dispatcher.h"
+#include "app_event_router.h"
 #include "app_event_watcher.h"
 #include "application_context.h"
 #include "file_util.h"
+#include "hiappevent_base.h"
 #include "os_event_listener.h"
 #include "time_util.h"
 
@@ -30,6 +37,7 @@ namespace OHOS {
 namespace {
 const std::string TEST_DIR = "/data/test/observer/hiappevent";
 const std::string XATTR_NAME = "user.appevent";
+constexpr uint64_t WAIT_TIMEOUT_MS = 1000;
 std::shared_ptr<OHOS::AbilityRuntime::ApplicationContext> g_applicationContext = nullptr;
 
 class ApplicationContextMock : public ApplicationContext {
@@ -45,6 +53,93 @@ uint64_t GetMaskFromDirXattr(const std::string& path)
     }
     return static_cast<uint64_t>(std::strtoull(value.c_str(), nullptr, 0));
 }
+
+class SlowObserver : public HiAppEvent::AppEventObserver {
+public:
+    // the non-real-time events are received by triggering the observer for each event
+    SlowObserver(const std::string& name, bool isRealTime)
+        : AppEventObserver(name, {}, { .row = 1 }), isRealTime_(isRealTime), release_(releasePromise_.get_future())
+    {}
+
+    void OnEvents(const std::vector<std::shared_ptr<AppEventPack>>& events) override
+    {
+        Receive(events.size());
+    }
+
+    void OnTrigger(const HiAppEvent::TriggerCondition& triggerCond) override
+    {
+        Receive(static_cast<size_t>(triggerCond.row));
+    }
+
+    bool IsRealTimeEvent(std::shared_ptr<AppEventPack> event) override
+    {
+        return isRealTime_;
+    }
+
+    void WaitForEnter()
+    {
+        enterPromise_.get_future().wait();
+    }
+
+    void Release()
+    {
+        releasePromise_.set_value();
+    }
+
+    size_t GetReceivedNum() const
+    {
+        return receivedNum_;
+    }
+
+private:
+    void Receive(size_t num)
+    {
+        if (receivedNum_ == 0) {
+            enterPromise_.set_value();
+            release_.wait();
+        }
+        receivedNum_ += num;
+    }
+
+private:
+    bool isRealTime_ = false;
+    std::promise<void> enterPromise_;
+    std::promise<void> releasePromise_;
+    std::shared_future<void> release_;
+    std::atomic<size_t> receivedNum_ = 0;
+};
+
+std::vector<std::shared_ptr<AppEventPack>> CreateEvents(size_t num)
+{
+    std::vector<std::shared_ptr<AppEventPack>> events;
+    for (size_t i = 0; i < num; ++i) {
+        events.emplace_back(std::make_shared<AppEventPack>("test_domain", "test_name", HiAppEvent::FAULT));
+    }
+    return events;
+}
+
+DispatchStats DispatchToSlowObserver(DispatchOverflowPolicy policy, bool isRealTime, size_t& receivedNum)
+{
+    auto observer = std::make_shared<SlowObserver>("slowObserver", isRealTime);
+    AppEventDispatcher dispatcher;
+    DispatchConfig config = { .maxQueueSize = 2, .overflowPolicy = policy };
+    dispatcher.SetConfig(observer->GetSeq(), config);
+    dispatcher.AddObserver(observer);
+
+    // the first event holds the worker of the observer, so that the later events wait in the queue
+    dispatcher.Dispatch(observer, CreateEvents(1));
+    observer->WaitForEnter();
+    for (size_t i = 0; i < 5; ++i) { // 5 events arrive while the observer is busy
+        dispatcher.Dispatch(observer, CreateEvents(1));
+    }
+    observer->Release();
+    EXPECT_TRUE(dispatcher.WaitIdle(WAIT_TIMEOUT_MS));
+
+    DispatchStats stats;
+    EXPECT_TRUE(dispatcher.GetStats(observer->GetSeq(), stats));
+    receivedNum = observer->GetReceivedNum();
+    return stats;
+}
 }
 
 namespace AbilityRuntime {
@@ -343,4 +438,111 @@ HWTEST_F(HiAppEventObserverTest, AppEventWatcher005, TestSize.Level0)
     appEventWatcher.SetFiltersStr(validFilter);
     EXPECT_EQ(appEventWatcher.GetFiltersStr(), validFilter);
 }
-}  // OHOS
\ No newline at end of file
+
+/**
+ * @tc.name: AppEventRouter001
+ * @tc.desc: test AppEventRouter routes the events to the observers matched by the filters
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventObserverTest, AppEventRouter001, TestSize.Level0)
+{
+    std::vector<std::shared_ptr<HiAppEvent::AppEventObserver>> observers = {
+        std::make_shared<HiAppEvent::AppEventObserver>("allEvents"),
+        std::make_shared<HiAppEvent::AppEventObserver>("domainOnly"),
+        std::make_shared<HiAppEvent::AppEventObserver>("nameAndType"),
+        std::make_shared<HiAppEvent::AppEventObserver>("emptyDomain"),
+    };
+    observers[1]->AddFilter(HiAppEvent::AppEventFilter("test_domain"));
+    observers[1]->AddFilter(HiAppEvent::AppEventFilter("test_domain", {"test_name"}));
+    observers[2]->AddFilter(HiAppEvent::AppEventFilter("test_domain", {"test_name"}, 1 << HiAppEvent::FAULT));
+    observers[3]->AddFilter(HiAppEvent::AppEventFilter());
+    AppEventRouter router(observers, 1);
+    ASSERT_EQ(router.GetVersion(), 1);
+
+    std::vector<size_t> indexes;
+    router.Route(std::make_shared<AppEventPack>("test_domain", "test_name", HiAppEvent::FAULT), indexes);
+    EXPECT_EQ(indexes, std::vector<size_t>({0, 1, 2}));
+    router.Route(std::make_shared<AppEventPack>("test_domain", "test_name", HiAppEvent::BEHAVIOR), indexes);
+    EXPECT_EQ(indexes, std::vector<size_t>({0, 1}));
+    router.Route(std::make_shared<AppEventPack>("test_domain", "other_name", HiAppEvent::FAULT), indexes);
+    EXPECT_EQ(indexes, std::vector<size_t>({0, 1}));
+    router.Route(std::make_shared<AppEventPack>("other_domain", "test_name", HiAppEvent::FAULT), indexes);
+    EXPECT_EQ(indexes, std::vector<size_t>({0}));
+
+    // the result is the same as verifying the event by each observer
+    auto event = std::make_shared<AppEventPack>("test_domain", "test_name", HiAppEvent::FAULT);
+    router.Route(event, indexes);
+    for (size_t i = 0; i < observers.size(); ++i) {
+        bool isRouted = std::find(indexes.begin(), indexes.end(), i) != indexes.end();
+        EXPECT_EQ(isRouted, observers[i]->VerifyEvent(event));
+    }
+
+    uint64_t version = HiAppEvent::AppEventObserver::GetFiltersVersion();
+    observers[0]->AddFilter(HiAppEvent::AppEventFilter("test_domain"));
+    EXPECT_GT(HiAppEvent::AppEventObserver::GetFiltersVersion(), version);
+}
+
+/**
+ * @tc.name: AppEventDispatcher001
+ * @tc.desc: test AppEventDispatcher bounds the queue of a slow observer by the overflow policy
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventObserverTest, AppEventDispatcher001, TestSize.Level0)
+{
+    size_t receivedNum = 0;
+    auto stats = DispatchToSlowObserver(DispatchOverflowPolicy::DROP_OLDEST, false, receivedNum);
+    EXPECT_EQ(stats.queueDepth, 0);
+    EXPECT_EQ(stats.maxQueueDepth, 2);
+    EXPECT_EQ(stats.deliveredNum, 3);
+    EXPECT_EQ(stats.droppedNum, 3);
+    EXPECT_EQ(receivedNum, 3);
+
+    // the spilled events are received by their number
+    stats = DispatchToSlowObserver(DispatchOverflowPolicy::SPILL_TO_DB, false, receivedNum);
+    EXPECT_EQ(stats.deliveredNum, 3);
+    EXPECT_EQ(stats.spilledNum, 3);
+    EXPECT_EQ(stats.droppedNum, 0);
+    EXPECT_EQ(receivedNum, 6);
+}
+
+/**
+ * @tc.name: AppEventDispatcher002
+ * @tc.desc: test AppEventDispatcher delivers all the real-time events to a slow observer by OnEvents
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventObserverTest, AppEventDispatcher002, TestSize.Level0)
+{
+    for (auto policy : { DispatchOverflowPolicy::DROP_OLDEST, DispatchOverflowPolicy::SPILL_TO_DB }) {
+        size_t receivedNum = 0;
+        auto stats = DispatchToSlowObserver(policy, true, receivedNum);
+        EXPECT_EQ(stats.maxQueueDepth, 5);
+        EXPECT_EQ(stats.deliveredNum, 6);
+        EXPECT_EQ(stats.droppedNum, 0);
+        EXPECT_EQ(stats.spilledNum, 0);
+        EXPECT_EQ(receivedNum, 6);
+    }
+}
+
+/**
+ * @tc.name: AppEventDispatcher003
+ * @tc.desc: test AppEventDispatcher does not deliver the events routed before the observer is removed
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventObserverTest, AppEventDispatcher003, TestSize.Level0)
+{
+    auto observer = std::make_shared<SlowObserver>("slowObserver", true);
+    observer->Release();
+    AppEventDispatcher dispatcher;
+    dispatcher.AddObserver(observer);
+    dispatcher.Dispatch(observer, CreateEvents(1));
+    EXPECT_TRUE(dispatcher.WaitIdle(WAIT_TIMEOUT_MS));
+    EXPECT_EQ(observer->GetReceivedNum(), 1);
+
+    dispatcher.RemoveObserver(observer->GetSeq());
+    dispatcher.Dispatch(observer, CreateEvents(1));
+    EXPECT_TRUE(dispatcher.WaitIdle(WAIT_TIMEOUT_MS));
+    EXPECT_EQ(observer->GetReceivedNum(), 1);
+    DispatchStats stats;
+    EXPECT_FALSE(dispatcher.GetStats(observer->GetSeq(), stats));
+}
+}  // OHOS
@@ -12,13 +12,17 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstring>
+#include <ctime>
 #include <iostream>
 
 #include <gtest/gtest.h>
 #include <json/json.h>
 
+#include "app_event_log_writer.h"
 #include "event_json_util.h"
 #include "file_util.h"
+#include "time_util.h"
 
 using namespace testing::ext;
 using namespace OHOS::HiviewDFX;
@@ -183,4 +187,66 @@ HWTEST_F(HiAppEventUtilityTest, HiAppEventFileUtil001, TestSize.Level1)
     isDir = FileUtil::IsDirectory(testDir);
     EXPECT_FALSE(isDir);
     std::cout << "HiAppEventFileUtil001 end" << std::endl;
-}
\ No newline at end of file
+}
+
+/**
+ * @tc.name: HiAppEventLogWriter001
+ * @tc.desc: test the log writer writes, rotates and reopens the log file.
+ * @tc.type: FUNC
+ * @tc.require: issueI5NTOS
+ */
+HWTEST_F(HiAppEventUtilityTest, HiAppEventLogWriter001, TestSize.Level1)
+{
+    std::cout << "HiAppEventLogWriter001 start" << std::endl;
+    std::string testDir = TEST_DIR + "log_writer/";
+    EXPECT_TRUE(FileUtil::ForceCreateDirectory(testDir));
+    AppEventLogWriter writer;
+    std::vector<std::string> contents = { "{\"name_\":\"event1\"}\n", "", "{\"name_\":\"event2\"}\n" };
+    uint64_t contentsSize = contents[0].size() + contents[2].size();
+    EXPECT_TRUE(writer.Write(testDir, {}));
+    EXPECT_TRUE(writer.Write(testDir, contents));
+    std::string firstFile = writer.GetFilePath();
+    EXPECT_EQ(FileUtil::GetFileSize(firstFile), contentsSize);
+
+    // the file is rotated when the size threshold is reached
+    writer.SetConfig({ .maxFileSize = contentsSize, .syncPolicy = LogSyncPolicy::PER_BATCH });
+    EXPECT_TRUE(writer.Write(testDir, contents));
+    std::string secondFile = writer.GetFilePath();
+    EXPECT_NE(firstFile, secondFile);
+    EXPECT_EQ(FileUtil::GetFileSize(secondFile), contentsSize);
+
+    // the file is recreated when it is deleted while being opened
+    EXPECT_TRUE(FileUtil::RemoveFile(secondFile));
+    EXPECT_TRUE(writer.Write(testDir, contents));
+    EXPECT_TRUE(FileUtil::IsFileExists(writer.GetFilePath()));
+    writer.Close();
+    EXPECT_TRUE(writer.GetFilePath().empty());
+    EXPECT_TRUE(FileUtil::ForceRemoveDirectory(testDir, true));
+    std::cout << "HiAppEventLogWriter001 end" << std::endl;
+}
+
+/**
+ * @tc.name: HiAppEventTimeUtil001
+ * @tc.desc: test the cached date and time zone are the same as the ones formatted from the local time.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventUtilityTest, HiAppEventTimeUtil001, TestSize.Level1)
+{
+    time_t nowTime = time(nullptr);
+    struct tm localTm {};
+    ASSERT_NE(localtime_noenv_r(&nowTime, &localTm), nullptr);
+    char dateChs[9] = { 0 }; // 9 means 8(19700101) + 1('\0')
+    ASSERT_NE(strftime(dateChs, sizeof(dateChs), "%Y%m%d", &localTm), 0);
+    char timeZoneChs[6] = { 0 }; // 6 means 5(+0800) + 1('\0')
+    ASSERT_NE(strftime(timeZoneChs, sizeof(timeZoneChs), "%z", &localTm), 0);
+
+    std::string date = TimeUtil::GetDate();
+    std::string timeZone = TimeUtil::GetTimeZone();
+    EXPECT_EQ(date.size(), strlen(dateChs));
+    EXPECT_EQ(timeZone, timeZoneChs);
+
+    // the cache is rebuilt after it is cleared
+    TimeUtil::ClearLocalTimeCache();
+    EXPECT_EQ(TimeUtil::GetDate(), date);
+    EXPECT_EQ(TimeUtil::GetTimeZone(), timeZone);
+}
@@ -12,7 +12,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 #include <gtest/gtest.h>
 
@@ -33,6 +37,8 @@ const std::string TEST_WATCHER_TIMEOUT = "watcher_time";
 const std::string TEST_DOMAIN = "test_domain";
 const std::string TEST_NAME = "test_name";
 constexpr unsigned int TEST_TYPE = 1;
+constexpr uint64_t WAIT_TIMEOUT_MS = 1000;
+constexpr int PERIOD_WAIT_MS = 1500; // longer than the period of the watchers
 const std::string TEST_EVENT = R"~({"domain_":"hiappevent", "name_":"testEvent"})~";
 
 std::shared_ptr<AppEventPack> CreateAppEventPack(const std::string& domain = TEST_DOMAIN)
@@ -68,14 +74,26 @@ public:
     void OnTrigger(const TriggerCondition& triggerCond) override
     {
         std::cout << GetName() << " onTrigger, row=" << triggerCond.row << ", size=" << triggerCond.size << std::endl;
+        std::lock_guard<std::mutex> lock(mutex_);
         triggerTimes++;
+        cond_.notify_all();
     }
 
     int GetTriggerTimes()
     {
+        std::lock_guard<std::mutex> lock(mutex_);
         return triggerTimes;
     }
 
+    // the events are delivered to the watcher asynchronously, so wait for the trigger with a timeout
+    bool WaitForTriggerTimes(int times)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cond_.wait_for(lock, std::chrono::milliseconds(WAIT_TIMEOUT_MS), [this, times] {
+            return triggerTimes >= times;
+        });
+    }
+
     void OnEvents(const std::vector<std::shared_ptr<AppEventPack>>& events) override
     {
         std::cout << GetName() << " OnEvents size=" << events.size() << std::endl;
@@ -88,6 +106,8 @@ public:
 
 private:
     int triggerTimes = 0;
+    std::mutex mutex_;
+    std::condition_variable cond_;
 };
 
 void BuildSimpleFilters(std::vector<AppEventFilter>& filters)
@@ -186,6 +206,8 @@ HWTEST_F(HiAppEventWatcherTest, HiAppEventWatcherTest001, TestSize.Level3)
     std::vector<std::shared_ptr<AppEventPack>> events;
     events.emplace_back(CreateAppEventPack());
     AppEventObserverFacade::HandleEvents(events);
+    ASSERT_TRUE(watcher2->WaitForTriggerTimes(1));
+    ASSERT_TRUE(watcher3->WaitForTriggerTimes(1));
     ASSERT_EQ(watcher1->GetTriggerTimes(), 0);
     ASSERT_EQ(watcher2->GetTriggerTimes(), 1);
     ASSERT_EQ(watcher3->GetTriggerTimes(), 1);
@@ -199,6 +221,10 @@ HWTEST_F(HiAppEventWatcherTest, HiAppEventWatcherTest001, TestSize.Level3)
     ASSERT_EQ(watcher3->GetTriggerTimes(), 1);
     ASSERT_EQ(watcher4->GetTriggerTimes(), 0);
 
+    // the watchers are triggered only after their periods of 1s
+    AppEventObserverFacade::HandleTimeout();
+    ASSERT_EQ(watcher4->GetTriggerTimes(), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(PERIOD_WAIT_MS));
     AppEventObserverFacade::HandleTimeout();
     ASSERT_EQ(watcher4->GetTriggerTimes(), 1);
     ASSERT_EQ(watcher5->GetTriggerTimes(), 1);
@@ -259,6 +285,7 @@ HWTEST_F(HiAppEventWatcherTest, HiAppEventWatcherTest003, TestSize.Level3)
     std::vector<std::shared_ptr<AppEventPack>> events;
     events.emplace_back(CreateAppEventPack());
     AppEventObserverFacade::HandleEvents(events);
+    ASSERT_TRUE(watcher2->WaitForTriggerTimes(1));
     ASSERT_EQ(watcher1->GetTriggerTimes(), 0);
     ASSERT_EQ(watcher2->GetTriggerTimes(), 1);
 
@@ -292,6 +319,36 @@ HWTEST_F(HiAppEventWatcherTest, HiAppEventWatcherTest004, TestSize.Level3)
     std::cout << "HiAppEventWatcherTest004 end" << std::endl;
 }
 
+/**
+ * @tc.name: HiAppEventWatcherTest005
+ * @tc.desc: Test the deadline of the periodic trigger of the watcher.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiAppEventWatcherTest, HiAppEventWatcherTest005, TestSize.Level3)
+{
+    /**
+     * @tc.steps: step1. create AppEventWatcher object with the period of 1s.
+     * @tc.steps: step2. check the deadline before and after the events are pending.
+     * @tc.steps: step3. check the watcher is triggered only when the deadline is reached.
+     */
+    std::cout << "HiAppEventWatcherTest005 start" << std::endl;
+
+    auto watcher = BuildWatcherWithTimeout();
+    constexpr int64_t now = 1000; // 1000ms since boot
+    ASSERT_EQ(watcher->GetTimeoutDeadline(now), 0);
+
+    watcher->ProcessEvents(1, 10); // 1 event of 10 bytes
+    ASSERT_EQ(watcher->GetTimeoutDeadline(now), 2000); // 2000ms, the deadline is 1s later
+    ASSERT_EQ(watcher->GetTimeoutDeadline(now + 500), 2000); // 500ms later, the deadline is not changed
+    watcher->ProcessTimeout(1999); // 1999ms, 1ms before the deadline
+    ASSERT_EQ(watcher->GetTriggerTimes(), 0);
+    watcher->ProcessTimeout(2000);
+    ASSERT_EQ(watcher->GetTriggerTimes(), 1);
+    ASSERT_EQ(watcher->GetTimeoutDeadline(2000), 0);
+
+    std::cout << "HiAppEventWatcherTest005 end" << std::endl;
+}
+
 /**
  * @tc.name: HiAppEventConfigTest001
  * @tc.desc: Test to add watcher onReceive.